@@ -0,0 +1,67 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <irrlicht.h>
+#include "Log.h"
+
+using namespace irr;
+
+// decoded images and meshes that outlive the Irrlicht device
+// a device created again (after changing the resolution or toggling fullscreen)
+//      gets them uploaded from memory instead of decoding the files again
+// textures and meshes should be requested here and not from the driver
+//      or the scene manager, only from the main thread
+class AssetCache
+{
+public:
+    static AssetCache &getInstance();
+
+    // texture of the file, uploaded from the cached image if the driver doesn't have it yet
+    video::ITexture *texture(IrrlichtDevice &device, const io::path &filename);
+    // mesh of the file, added to the mesh cache of the scene manager if it isn't there yet
+    scene::IAnimatedMesh *mesh(IrrlichtDevice &device, const io::path &filename);
+
+    // texture of the images packed into one, like texture() it's kept in memory
+    // rects get the place of each image in it, in the order of the files
+    video::ITexture *atlas(IrrlichtDevice &device, const io::path &name,
+                           const std::vector<io::path> &filenames, std::vector<core::recti> &rects);
+
+    // uploads all the cached textures and meshes to a new device
+    // returns the time in ms
+    float restore(IrrlichtDevice &device);
+
+    // drops all the cached images and meshes
+    void clear();
+
+private:
+    AssetCache() = default;
+    ~AssetCache();
+
+    AssetCache(const AssetCache &) = delete;
+    AssetCache &operator =(const AssetCache &) = delete;
+
+    std::unordered_map<std::string, video::IImage *> m_images;
+    std::unordered_map<std::string, scene::IAnimatedMesh *> m_meshes;
+    std::unordered_map<std::string, std::vector<core::recti>> m_atlasRects;
+};
+
+#endif // ASSETCACHE_H
@@ -0,0 +1,42 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <functional>
+#include <vector>
+
+// loads the assets that would otherwise be loaded on first use,
+//      independent assets are loaded in parallel and the time of each is logged
+// only CPU-side assets are loaded here, textures and Irrlicht meshes
+//      need the thread of the video driver
+class AssetLoader
+{
+public:
+    struct Asset {
+        const char *name;
+        std::function<void()> load;
+    };
+
+    static std::vector<Asset> assets();
+
+    // returns the time of the whole phase in ms
+    static float loadAll();
+};
+
+#endif // ASSETLOADER_H
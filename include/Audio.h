@@ -17,10 +17,9 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
+#include <array>
 #include <memory>
 #include <thread>
-#include <queue>
-#include <list>
 #include <SFML/Audio.hpp>
 #include "Log.h"
 #include "util/Vector3.h"
@@ -30,31 +29,54 @@
 #define BACKGROUND_FILE "media/sounds/background.ogg"
 #define MENU_FILE "media/sounds/menu.ogg"
 
+// short sounds played from the voice pool,
+//      the order is the priority (a later one may steal the voice of an earlier one)
+enum class Effect { COLLISION, EXPLOSION };
+// long sounds streamed from their files
+enum class Track { BACKGROUND, MENU, COUNT };
+
 class Audio {
     Audio();
 
     sf::SoundBuffer collisionBuffer;
     sf::SoundBuffer explosionBuffer;
-    sf::SoundBuffer backgroundBuffer;
-    sf::SoundBuffer menuBuffer;
 
-    static std::queue<sf::Sound, std::list<sf::Sound>> queue;
-    static void clearQueue();
+    // opened on first use
+    std::array<std::unique_ptr<sf::Music>, static_cast<std::size_t>(Track::COUNT)> tracks;
+
+    struct Voice {
+        sf::Sound sound;
+        Effect effect = Effect::COLLISION;
+        float volume = 0;
+    };
 
-    static Audio instance;
+    // effects are played by a fixed set of voices which are reused when they finish,
+    //      if all of them are busy the quietest voice of the lowest priority is stolen
+    static constexpr std::size_t VOICES = 32;
+    std::array<Voice, VOICES> voices;
+    std::size_t m_dropped = 0;
+
+    const sf::SoundBuffer &buffer(Effect effect) const;
+    Voice *acquireVoice(Effect effect, float volume);
+    // acquires a voice and sets it up for the effect, nullptr if the sound is dropped
+    Voice *prepareVoice(Effect effect, float volume);
 public:
-    static Audio &getInstance()
-    {
-        return instance;
-    }
-
-    sf::Sound collision() const;
-    sf::Sound explosion() const;
-    sf::Sound background() const;
-    sf::Sound menu() const;
-
-    static void play(sf::Sound sound, float volume = -1);
-    static void playAt(sf::Sound sound, const Vector3<float> &position, float volume = -1);
+    // the effects are loaded on the first call
+    static Audio &getInstance();
+
+    sf::Music &music(Track track);
+
+    // memory taken by the decoded effects
+    std::size_t bufferBytes() const;
+
+    // volume is from 0 to 100
+    void play(Effect effect, float volume = 100);
+    void playAt(Effect effect, const Vector3<float> &position, float volume = 100);
+
+    // number of voices playing the effect
+    std::size_t playing(Effect effect) const;
+    // number of effects that didn't get a voice
+    std::size_t dropped() const { return m_dropped; }
 };
 
 #endif // AUDIO_H
@@ -0,0 +1,97 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINARYMESH_H
+#define BINARYMESH_H
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionShapes/btShapeHull.h>
+#include "ObjMesh.h"
+#include "Log.h"
+#include "util/MappedFile.h"
+
+// precompiled mesh made by tools/meshconv out of an OBJ model
+//
+// the file is mapped into memory and used as it is:
+//      header
+//      vertices   (vertexCount btVector3s)
+//      hull       (hullCount btVector3s, simplified convex hull
+//                  that collision shapes are built of)
+//      indices    (indexCount uint32s, three per triangle)
+// btVector3s are stored in their in-memory representation, so a file
+//      is only valid for a build with the same btScalar
+//
+// if there's no valid binary file next to the OBJ model, the model
+//      itself is parsed (slowly) and kept in memory instead
+class BinaryMesh
+{
+public:
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t scalarSize;
+        std::uint32_t vertexCount;
+        std::uint32_t hullCount;
+        std::uint32_t indexCount;
+        std::uint32_t reserved[2]; // keeps the vertices 16-byte aligned
+    };
+
+    static constexpr char MAGIC[4] = { 'P', 'L', 'M', 'S' };
+    static constexpr std::uint32_t VERSION = 2;
+
+    BinaryMesh(const std::string &objFilename);
+
+    // converts an OBJ mesh into the binary format
+    static bool save(const std::string &filename, const ObjMesh &objMesh);
+    // "media/models/cone.obj" -> "media/models/cone.mesh"
+    static std::string binaryFilename(const std::string &objFilename);
+
+    const btVector3 *getPoints() const { return m_vertices; }
+    std::size_t getPointsCount() const { return m_vertexCount; }
+
+    const btVector3 *getHullPoints() const { return m_hull; }
+    std::size_t getHullPointsCount() const { return m_hullCount; }
+
+    std::unique_ptr<btTriangleMesh> getTriangleMesh(btScalar scale = 1.0f) const;
+
+    // reduces vertices to a minimal set of convex hull points
+    static std::vector<btVector3> hullPoints(const std::vector<btVector3> &vertices);
+
+private:
+    bool loadBinary(const std::string &filename);
+    void loadObj(const std::string &filename);
+
+    MappedFile m_file;
+
+    // storage for meshes that are not mapped from a binary file
+    std::vector<btVector3> m_objVertices;
+    std::vector<btVector3> m_objHull;
+    std::vector<std::uint32_t> m_objIndices;
+
+    const btVector3 *m_vertices = nullptr;
+    const btVector3 *m_hull = nullptr;
+    const std::uint32_t *m_indices = nullptr;
+    std::size_t m_vertexCount = 0;
+    std::size_t m_hullCount = 0;
+    std::size_t m_indexCount = 0;
+};
+
+#endif // BINARYMESH_H
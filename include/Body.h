@@ -24,6 +24,7 @@
 #include "util/NaN.h"
 #include "util/math.h"
 #include "util/other.h"
+#include "util/MemoryStats.h"
 
 using namespace irr;
 
@@ -49,6 +50,19 @@ public:
 
     virtual ~Body();
 
+    // counts only the object itself, see MemoryCategory
+    static void *operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MemoryCategory::BODIES, size);
+        return ::operator new(size);
+    }
+
+    static void operator delete(void *pointer, std::size_t size)
+    {
+        MemoryStats::freed(MemoryCategory::BODIES, size);
+        ::operator delete(pointer);
+    }
+
     btRigidBody &rigidBody() { return *m_rigidBody; }
     const btRigidBody &rigidBody() const { return *m_rigidBody; }
 
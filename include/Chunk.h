@@ -21,6 +21,7 @@
 #include <vector>
 #include <algorithm>
 #include "Patterns.h"
+#include "bodies/CompoundProducer.h"
 #include "util/Randomizer.h"
 #include "util/other.h"
 #include "util/Array3.h"
@@ -45,9 +46,11 @@ private:
 public:
     Chunk() = default;
 
-    void generate()
+    // density scales the number of patterns put into the chunk
+    void generate(float density = 1.0f)
     {
         std::vector<PatternPosition> positions;
+        const std::size_t cloudSize = std::max<std::size_t>(1, Size * Size / 4 * density);
 
         switch (Randomizer::getInt(0, 2)) {
         case 0: { // cloud of crystals
@@ -55,13 +58,13 @@ public:
             do {
                 positions.clear();
 
-                positions.reserve(Size * Size / 4);
-                for (std::size_t i = 0; i < Size * Size / 4; i++) {
-                    const int patternIndex = Randomizer::getInt(0, Patterns::crystals.size() - 1);
+                positions.reserve(cloudSize);
+                for (std::size_t i = 0; i < cloudSize; i++) {
+                    const int patternIndex = Randomizer::getInt(0, Patterns::crystals().size() - 1);
 
-                    positions.push_back(randomPosition(Patterns::crystals[patternIndex]));
+                    positions.push_back(randomPosition(Patterns::crystals()[patternIndex]));
                 }
-            } while ((n = collisions(positions)) < Size * Size / 8);
+            } while ((n = collisions(positions)) < cloudSize / 2);
             positions.resize(n);
             type = ChunkType::CLOUD;
 
@@ -73,13 +76,13 @@ public:
             do {
                 positions.clear();
 
-                positions.reserve(Size * Size / 4);
-                for (std::size_t i = 0; i < Size * Size / 4; i++) {
-                    const int patternIndex = Randomizer::getInt(0, Patterns::cubes.size() - 1);
+                positions.reserve(cloudSize);
+                for (std::size_t i = 0; i < cloudSize; i++) {
+                    const int patternIndex = Randomizer::getInt(0, Patterns::cubes().size() - 1);
 
-                    positions.push_back(randomPosition(Patterns::cubes[patternIndex]));
+                    positions.push_back(randomPosition(Patterns::cubes()[patternIndex]));
                 }
-            } while ((n = collisions(positions)) < Size * Size / 8);
+            } while ((n = collisions(positions)) < cloudSize / 2);
             positions.resize(n);
             type = ChunkType::CLOUD;
 
@@ -90,12 +93,12 @@ public:
             do {
                 positions.clear();
 
-                const std::size_t count = Randomizer::getInt(5, 10);
+                const std::size_t count = std::max<std::size_t>(1, Randomizer::getInt(5, 10) * density);
                 positions.reserve(count);
                 for (std::size_t i = 0; i < count; i++) {
-                    const int patternIndex = Randomizer::getInt(0, Patterns::all.size() - 1);
+                    const int patternIndex = Randomizer::getInt(0, Patterns::all().size() - 1);
 
-                    positions.push_back(randomPosition(Patterns::all[patternIndex]));
+                    positions.push_back(randomPosition(Patterns::all()[patternIndex]));
                 }
             } while (collisions(positions) != positions.size());
             type = ChunkType::RANDOM;
@@ -172,7 +175,14 @@ private:
             const auto &pattern = *position.pattern;
             const Vector3<int> &pos = position.position;
 
-            for (auto &producer : pattern.producers()) {
+            std::vector<std::unique_ptr<IBodyProducer>> producers = pattern.producers();
+            if (pattern.compound()) {
+                auto compound = std::make_unique<CompoundProducer>(std::move(producers));
+                producers.clear();
+                producers.push_back(std::move(compound));
+            }
+
+            for (auto &producer : producers) {
                 // producer pos relative to pattern
                 btVector3 &origin = producer->relativeTransform.getOrigin();
                 origin += pos * CELL_LENGTH;
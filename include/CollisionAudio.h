@@ -0,0 +1,65 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COLLISIONAUDIO_H
+#define COLLISIONAUDIO_H
+
+#include <cstdint>
+#include <vector>
+#include <btBulletDynamicsCommon.h>
+#include "Audio.h"
+
+// gathers collision sounds of a step and plays them at most once per pair or place
+//      within a time window, so that a grinding contact doesn't start
+//      a new sound on every substep
+class CollisionAudio
+{
+public:
+    // merged events within this distance
+    static constexpr btScalar CELL_SIZE = 50;
+    // in seconds
+    static constexpr btScalar WINDOW = 0.15f;
+    // collision voices playing at once
+    static constexpr std::size_t MAX_VOICES = 8;
+    // aggregated impulse played at full volume
+    static constexpr btScalar FULL_VOLUME_IMPULSE = 400;
+
+    CollisionAudio();
+
+    void add(const btCollisionObject *objA, const btCollisionObject *objB,
+             const btVector3 &position, btScalar impulse);
+    // plays the gathered events, timeStep is the time since the last flush
+    void flush(btScalar timeStep);
+
+private:
+    struct Event {
+        const btCollisionObject *objA;
+        const btCollisionObject *objB;
+        std::int32_t cell[3];
+        btVector3 position;     // weighted by impulse
+        btScalar impulse;
+        btScalar time;          // when it was played
+    };
+
+    bool sameSource(const Event &a, const Event &b) const;
+
+    std::vector<Event> m_pending;
+    std::vector<Event> m_played;
+    btScalar m_time = 0;
+};
+
+#endif // COLLISIONAUDIO_H
@@ -25,6 +25,8 @@
 #include <cctype>
 #include <irrlicht.h>
 #include "Log.h"
+#include "util/MappedFile.h"
+#include "util/Tokenizer.h"
 #include "util/other.h"
 
 using namespace irr;
@@ -68,6 +70,7 @@ struct ConfigData {
     bool vsync = true;
     bool stencilBuffer = true;
     u32 renderDistance = 2000;
+    u32 menuFPS = 15;   // menu redraws per second without input, 0 is unlimited
     int volume = 100;
     Controls controls;
 
@@ -89,114 +92,39 @@ struct ConfigData {
 //      ...
 // expression can be either a string ("bla-bla") or
 //      a boolean (on/off) or an integer or
-//      a float or a resolution (int,int)
+//      a resolution (int,int)
 // also controls are set like this:
 //      controls:
 //          key1=keyCode
 //          key2=keyCode
 //          ...
+//
+// the variables are described by the schema, a new one only needs a new entry there
 class Config
 {
 public:
-    static ConfigData loadConfig(const std::string &filename);
-    static void saveConfig(const std::string &filename, const ConfigData &data);
-
-private:
-    struct Item {
-        enum ItemType { INT, FLOAT, STRING, KEYWORD, OP_EQUAL, OP_COMMA, OP_COLON, NEWLINE };
-
-        Item(ItemType type) :
-            type(type) {}
-
-        Item(ItemType type, const std::string &text) :
-            type(type), data((void *) new std::string(text)) {}
-
-        Item(ItemType type, f32 floatNumber) :
-            type(type), data((void *) new f32)
-        {
-            *(f32 *) data = floatNumber;
-        }
-
-        Item(ItemType type, s32 intNumber) :
-            type(type), data((void *) new s32)
-        {
-            *(s32 *) data = intNumber;
-        }
-
-        Item(Item &&item) noexcept :
-            type(item.type), data(item.data)
-        {
-            item.data = nullptr;
-        }
-
-        ~Item()
-        {
-            switch (type) {
-            case INT:
-                delete (int *) data;
-                break;
-            case FLOAT:
-                delete (float *) data;
-                break;
-            case STRING:
-            case KEYWORD:
-                delete (std::string *) data;
-                break;
-            default:
-                break;
-            }
-        }
-
-        std::string getString()
-        {
-            return *(std::string *) data;
-        }
-
-        const std::string &getString() const
-        {
-            return *(std::string *) data;
-        }
-
-        f32 getFloat() const
-        {
-            return *(f32 *) data;
-        }
-
-        s32 getInt() const
-        {
-            return *(s32 *) data;
-        }
+    struct Value {
+        long first = 0;     // integers, booleans and key codes
+        long second = 0;    // height of a resolution
+        std::string string;
+    };
 
-        static std::string typeToString(ItemType type)
-        {
-            switch (type) {
-            case INT:
-                return "integer";
-            case FLOAT:
-                return "float";
-            case STRING:
-                return "string";
-            case KEYWORD:
-                return "keyword";
-            case OP_EQUAL:
-                return "'='";
-            case OP_COMMA:
-                return "comma";
-            case OP_COLON:
-                return ":";
-            case NEWLINE:
-                return "new line or end of file";
-            default:
-                return "";
-            }
-        }
+    struct Option {
+        enum Type { BOOL, INT, STRING, RESOLUTION, KEY };
 
-        ItemType type;
-        void *data = nullptr;
+        const char *name;
+        const char *section;    // nullptr if it's not in a section
+        Type type;
+        // valid range of integers
+        long min, max;
+        void (*set)(ConfigData &data, const Value &value);
+        Value (*get)(const ConfigData &data);
     };
 
-    static std::vector<Item> parse(const std::string &filename);
-    static void warning(Item::ItemType expected, Item::ItemType found);
+    static const std::vector<Option> &schema();
+
+    static ConfigData loadConfig(const std::string &filename);
+    static void saveConfig(const std::string &filename, const ConfigData &data);
 };
 
 #endif // CONFIG_H
@@ -41,6 +41,8 @@ public:
 
     bool checkEvent(GUI_ID id);
     bool checkKeyPressed(EKEY_CODE keyCode);
+    // true if a key, mouse or GUI event came since the last call
+    bool checkInput();
 private:
     std::array<bool, KEY_KEY_CODES_COUNT> pressedKeys; // this array shows which keys are pressed and which are not
     std::array<bool, KEY_KEY_CODES_COUNT> checkedKeys;
@@ -48,6 +50,7 @@ private:
     EKEY_CODE lastKey = KEY_KEY_CODES_COUNT; // last pressed key (only works in Controls menu)
 
     bool catchingKey = false;
+    bool input = false;
 };
 
 #endif // EVENTRECEIVER_H
@@ -24,6 +24,7 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include "Log.h"
+#include "AssetCache.h"
 
 using namespace irr;
 
@@ -17,16 +17,27 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <cstdint>
+#include <ctime>
+#include <cstdio>
 #include <iostream>
 #include <thread>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <exception>
+#include <random>
+#include <string>
+#include <cstring>
+#include <numeric>
 #include <irrlicht.h>
 #include <btBulletDynamicsCommon.h>
 #include <ITimer.h>
 #include "World.h"
+#include "AssetCache.h"
+#include "AssetLoader.h"
 #include "gui/GUI.h"
 #include "gui/GUIID.h"
 #include "gui/screens/ControlSettingsScreen.h"
@@ -39,15 +50,22 @@
 #include "EventReceiver.h"
 #include "Config.h"
 #include "Scoreboard.h"
+#include "ScoreStore.h"
 #include "ObstacleGenerator.h"
 #include "Plane.h"
 #include "PlaneControl.h"
+#include "InputRecording.h"
+#include "PerfRunner.h"
 #include "DebugDrawer.h"
 #include "Explosion.h"
 #include "Patterns.h"
 #include "Chunk.h"
 #include "util/i18n.h"
 #include "util/CGUITTFont.h"
+#include "util/FrameStats.h"
+#include "util/MemoryStats.h"
+#include "util/Profiler.h"
+#include "util/TraceRecorder.h"
 #include "util/options.h"
 #include "util/exceptions.h"
 
@@ -56,17 +74,30 @@ using namespace irr;
 class Game
 {
 public:
-    Game(const struct ConfigData &data = ConfigData());
+    Game(const struct ConfigData &data = ConfigData(),
+         video::E_DRIVER_TYPE driverType = video::EDT_OPENGL);
     ~Game();
     void start();
 
+    // every run started from the menu is recorded into the file
+    void setRecordingFile(const std::string &filename);
+    // plays a recorded flight back, returns false if the file can't be read
+    bool replay(const std::string &filename);
+    // runs the performance scenarios, see PerfRunner
+    bool perf(const std::string &outputFile, const std::string &replayFile);
+    bool perfText(const std::string &outputFile);
+
+    static std::unique_ptr<ChunkDB> generateChunkDB(std::uint32_t seed, float density = 1.0f);
+
 private:
     bool initialized = false;
 
-    bool run(std::unique_ptr<ChunkDB> chunkDB);
+    bool run(std::unique_ptr<ChunkDB> chunkDB, std::uint32_t seed);
     void mainMenu();
 
     ConfigData configuration;
+    video::E_DRIVER_TYPE driverType;
+    std::string recordingFile;
     std::unique_ptr<GUI> gui;
     IrrlichtDevice *device;
     video::IVideoDriver *driver;
@@ -78,17 +109,31 @@ private:
     ITimer *timer;
 
     std::unique_ptr<World> world;
+
+    FrameStats frameStats;
+
+    // memory stats of the previous update, to compute allocation rates
+    MemoryStats::Snapshot lastMemorySnapshot {};
+    u32 lastMemoryUpdate = 0;
+    u32 memoryUpdates = 0;
     std::unique_ptr<PlaneControl> planeControl;
 
     void initializeDevice();
     void initializeGUI();
     void terminateDevice();
-    void setSpriteBank(bool);
+    // for changed video settings, which need a new device
+    void recreateDevice();
+    void setSpriteBanks();
+    // loads the glyphs of the current language into the font at once
+    void prewarmFont();
 
     void updateHUD();
+    // draws the GUI, the texts of the HUD in one batch
+    void drawGUI();
+    void updateMemoryStats();
+    // completes the record of a finished run and stores it
+    void saveRun(RunRecord &record, std::vector<float> &frameTimes);
     void handleSelecting();
-
-    static std::unique_ptr<ChunkDB> generateChunkDB();
 };
 
 #endif // GAME_H
@@ -0,0 +1,81 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Log.h"
+#include "util/MappedFile.h"
+
+// pressed controls, bit CONTROL::X is set if the control is pressed
+using ControlState = std::uint8_t;
+
+// a flight recorded by InputRecorder and played back by InputReplay
+//
+// file layout:
+//      header
+//      frames, each of them is
+//          step  (uint32, simulation step of the frame in ms)
+//          ticks (uint8, number of fixed ticks handled during the frame)
+//          ticks ControlStates, one per tick
+// the world is generated from the seed, so with the same build
+//      a replay reproduces the same flight
+struct InputRecordingHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t seed;
+    std::uint32_t renderDistance;
+};
+
+class InputRecorder
+{
+public:
+    static constexpr char MAGIC[4] = { 'P', 'L', 'R', 'P' };
+    static constexpr std::uint32_t VERSION = 1;
+
+    bool open(const std::string &filename, std::uint32_t seed, std::uint32_t renderDistance);
+    bool isOpen() const { return m_file.is_open(); }
+
+    // adds one frame, ticks are the controls of every tick of the frame
+    void frame(std::uint32_t step, const std::vector<ControlState> &ticks);
+
+private:
+    std::ofstream m_file;
+};
+
+class InputReplay
+{
+public:
+    bool open(const std::string &filename);
+
+    std::uint32_t seed() const { return m_header.seed; }
+    std::uint32_t renderDistance() const { return m_header.renderDistance; }
+
+    // reads the next frame, returns false at the end of the recording
+    bool nextFrame(std::uint32_t &step, std::vector<ControlState> &ticks);
+
+private:
+    MappedFile m_file;
+    InputRecordingHeader m_header {};
+    std::size_t m_position = 0;
+};
+
+#endif // INPUTRECORDING_H
@@ -14,14 +14,18 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef LOG_H
 #define LOG_H
 
+#include <atomic>
 #include <fstream>
 #include <ostream>
+#include <streambuf>
 #include <string>
-#include <mutex>
+#include <thread>
 #include <utility>
+#include "util/options.h"
 
 const std::string LOG_FILE { "logfile" };
 
@@ -50,120 +54,127 @@ static inline std::ostream &operator <<(std::ostream &out, severity_level level)
     return out;
 }
 
-static inline std::wostream &operator <<(std::wostream &wout, severity_level level)
-{
-    switch (level) {
-    case severity_level::error:
-        wout << L"ERROR   :";
-        break;
-    case severity_level::warning:
-        wout << L"WARNING :";
-        break;
-    case severity_level::notice:
-        wout << L"NOTICE  :";
-        break;
-    case severity_level::info:
-        wout << L"INFO    :";
-        break;
-    case severity_level::debug:
-        wout << L"DEBUG   :";
-        break;
-    }
+// records are formatted by the calling thread into a fixed-size slot
+//      of a lock-free ring and written to LOG_FILE by a background thread
+// if the ring is full errors and warnings wait for a free slot,
+//      other records are dropped and counted
+class Log {
+    Log();
 
-    return wout;
-}
+    static constexpr std::size_t RECORD_SIZE = 256;
+    static constexpr std::size_t RING_SIZE = 1024; // must be a power of two
 
-class Log {
-    Log() = default;
+    struct Record {
+        std::atomic<std::size_t> sequence;
+        std::size_t length;
+        char text[RECORD_SIZE];
+    };
+
+    // std::ostream writing into a fixed array, long records are cut off
+    class Formatter : public std::streambuf {
+    public:
+        Formatter() :
+            stream(this) { reset(); }
+
+        void reset()
+        {
+            setp(m_text, m_text + RECORD_SIZE);
+            stream.clear();
+        }
+
+        const char *data() const { return pbase(); }
+        std::size_t size() const { return pptr() - pbase(); }
+
+        std::ostream stream;
+    private:
+        char m_text[RECORD_SIZE];
+    };
 
     std::ofstream out { LOG_FILE };
-    std::wofstream wout { LOG_FILE };
-    std::mutex mutex;
 
-    static Log instance;
+    Record m_ring[RING_SIZE];
+    std::atomic<std::size_t> m_enqueuePos { 0 };
+    std::size_t m_dequeuePos = 0;
+    std::atomic<std::size_t> m_dropped { 0 };
+    std::size_t m_reportedDropped = 0;
+
+    std::atomic<bool> m_running { true };
+    std::thread m_writer;
 public:
+    ~Log();
+
+    Log(const Log &) = delete;
+    Log &operator =(const Log &) = delete;
+
+    // constructed on first use, static meshes log while being initialized
     static Log &getInstance()
     {
+        static Log instance;
         return instance;
     }
 
-    template <typename... Args>
-    void write(severity_level level, Args &&... args)
+    // whether records of the level are compiled in, see LOG_LEVEL
+    // the arguments of a call are evaluated anyway, so calls in hot code
+    //      with costly arguments are guarded with it
+    static constexpr bool enabled(severity_level level)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        out << level << " ";
-        (void)(int []){ 0, (out << std::forward<Args>(args), 0)... };
-        out << std::endl;
+        return static_cast<int>(level) <= LOG_LEVEL;
     }
 
     template <typename... Args>
-    void wwrite(severity_level level, Args &&... args)
+    void write(severity_level level, Args &&... args)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        wout << level << L" ";
-        (void)(int []){ 0, (out << std::forward<Args>(args), 0)... };
-        wout << std::endl;
-    }
+        static thread_local Formatter formatter;
 
-    template <typename... Args>
-    void error(Args &&... args)
-    {
-        write(severity_level::error, std::forward<Args>(args)...);
+        formatter.reset();
+        formatter.stream << level << " ";
+        using expand = int[];
+        (void)expand{ 0, (formatter.stream << std::forward<Args>(args), 0)... };
+        push(level, formatter.data(), formatter.size());
     }
 
     template <typename... Args>
-    void werror(Args &&... args)
+    void error(Args &&... args)
     {
-        wwrite(severity_level::error, std::forward<Args>(args)...);
+        if (enabled(severity_level::error))
+            write(severity_level::error, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     void warning(Args &&... args)
     {
-        write(severity_level::warning, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void wwarning(Args &&... args)
-    {
-        wwrite(severity_level::warning, std::forward<Args>(args)...);
+        if (enabled(severity_level::warning))
+            write(severity_level::warning, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     void notice(Args &&... args)
     {
-        write(severity_level::notice, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void wnotice(Args &&... args)
-    {
-        wwrite(severity_level::notice, std::forward<Args>(args)...);
+        if (enabled(severity_level::notice))
+            write(severity_level::notice, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     void info(Args &&... args)
     {
-        write(severity_level::info, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void winfo(Args &&... args)
-    {
-        wwrite(severity_level::info, std::forward<Args>(args)...);
+        if (enabled(severity_level::info))
+            write(severity_level::info, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     void debug(Args &&... args)
     {
-        write(severity_level::debug, std::forward<Args>(args)...);
+        if (enabled(severity_level::debug))
+            write(severity_level::debug, std::forward<Args>(args)...);
     }
 
-    template <typename... Args>
-    void wdebug(Args &&... args)
-    {
-        wwrite(severity_level::debug, std::forward<Args>(args)...);
-    }
+    // number of records dropped because the ring was full
+    std::size_t dropped() const;
+
+private:
+    void push(severity_level level, const char *text, std::size_t length);
+    bool pop();
+    void writerLoop();
 };
 
 #endif // LOG_H
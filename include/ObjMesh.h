@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <cstdint>
 #include <btBulletDynamicsCommon.h>
 #include "Log.h"
 
@@ -37,6 +38,10 @@ public:
     std::size_t getPointsCount() const;
     void setPoints(btConvexHullShape &shape);
 
+    const std::vector<btVector3> &getVertices() const;
+    // polygons triangulated as fans, three vertex indices per triangle
+    std::vector<std::uint32_t> getTriangleIndices() const;
+
 private:
     std::vector<btVector3> vertices;
     std::vector<std::vector<std::size_t>> polygons;
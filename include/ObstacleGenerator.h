@@ -24,9 +24,11 @@
 #include "MotionState.h"
 #include "Patterns.h"
 #include "Chunk.h"
+#include "bodies/CompoundProducer.h"
 #include "Log.h"
 #include "util/Randomizer.h"
 #include "util/Cuboid.h"
+#include "util/TraceRecorder.h"
 #include "util/other.h"
 #include "util/options.h"
 
@@ -42,8 +44,12 @@ public:
                       btScalar buffer = CHUNK_LENGTH);
 
     void generate(const btVector3 &playerPosition, const ChunkDB &chunkDB);
+    // replaces the given compound bodies by their parts
+    void breakApart(const std::vector<const btCollisionObject *> &compounds);
 
     std::size_t obstacles() const;
+    // obstacles removed because the plane left them behind
+    std::size_t passed() const { return m_passed; }
     btScalar farValue() const;
     btScalar buffer() const;
 
@@ -71,6 +77,7 @@ private:
     std::list<std::unique_ptr<Body>> m_obstacles;
 
     u32 obstacleCount = 0;
+    std::size_t m_passed = 0;
 
     btScalar m_farValue = 0;
     // buffer is used to generate obstacles a bit farther than
@@ -36,9 +36,10 @@ private:
 public:
     Patterns() = delete;
 
-    static const std::array<std::shared_ptr<IObstaclePattern>, ALL> all;
-    static const std::array<std::shared_ptr<IObstaclePattern>, CRYSTALS> crystals;
-    static const std::array<std::shared_ptr<IObstaclePattern>, CUBES> cubes;
+    // built on first use
+    static const std::array<std::shared_ptr<IObstaclePattern>, ALL> &all();
+    static const std::array<std::shared_ptr<IObstaclePattern>, CRYSTALS> &crystals();
+    static const std::array<std::shared_ptr<IObstaclePattern>, CUBES> &cubes();
 };
 
 #endif // PATTERNS_H
@@ -0,0 +1,88 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PERFRUNNER_H
+#define PERFRUNNER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <irrlicht.h>
+#include <btBulletDynamicsCommon.h>
+#include "World.h"
+#include "Config.h"
+#include "InputRecording.h"
+#include "util/Profiler.h"
+
+using namespace irr;
+
+// runs a fixed matrix of scenarios (usually on the null driver) and writes
+//      their results as JSON, so that runs of different builds can be compared
+// every scenario flies for a fixed number of 1/60 s ticks with one tick per frame,
+//      the controls are taken from a recording or from a built-in script
+// separately, on a real driver, a text-heavy screen is drawn with and without
+//      batching the glyphs
+class PerfRunner
+{
+public:
+    struct Scenario {
+        std::string name;
+        std::uint32_t seed;
+        u32 renderDistance;
+        float density;          // see Chunk::generate
+        btScalar cameraDistance;
+        u32 seconds;            // of simulated time
+    };
+
+    PerfRunner(IrrlichtDevice &device, const ConfigData &configuration);
+
+    static std::vector<Scenario> scenarios();
+
+    // replayFile may be empty
+    bool run(const std::string &outputFile, const std::string &replayFile);
+    // the null driver draws nothing, so this needs a window
+    bool runText(const std::string &outputFile);
+
+private:
+    struct Result {
+        std::size_t frames = 0;
+        bool crashed = false;
+        float generationTime = 0; // ms
+        std::array<std::vector<float>, STAGE_COUNT> stages;
+        std::size_t peakObstacles = 0;
+        std::uint32_t seed = 0;             // the recording's one when replaying
+        std::size_t peakTrackedMemory = 0;  // sum of the MemoryStats categories, not the process
+        std::size_t peakPairs = 0;
+        double averagePairs = 0;
+    };
+
+    // a screen of static texts with backgrounds, like the HUD with everything shown
+    static constexpr u32 TEXT_COLUMNS = 2;
+    static constexpr u32 TEXT_ROWS = 24;
+    static constexpr u32 TEXT_FRAMES = 600;
+
+    Result runScenario(const Scenario &scenario, const std::string &replayFile);
+    // time in ms spent drawing the text screen in each frame
+    std::vector<float> runTextBenchmark(bool batched);
+    static ControlState scriptedControls(std::size_t tick);
+
+    IrrlichtDevice &m_device;
+    const ConfigData &m_configuration;
+};
+
+#endif // PERFRUNNER_H
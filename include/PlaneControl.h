@@ -21,6 +21,7 @@
 #include "EventReceiver.h"
 #include "Config.h"
 #include "Plane.h"
+#include "InputRecording.h"
 #include "util/constants.h"
 
 class PlaneControl
@@ -28,6 +29,10 @@ class PlaneControl
 public:
     PlaneControl(Plane &plane, const Controls &controls = Controls());
     void handle(EventReceiver &eventReceiver);
+    void handle(ControlState state);
+
+    // controls pressed at the moment
+    ControlState read(const EventReceiver &eventReceiver) const;
 
 private:
     static constexpr btScalar FORWARD_IMPULSE = 150;
@@ -21,9 +21,10 @@
 #include <irrlicht.h>
 #include <btBulletDynamicsCommon.h>
 #include "interfaces/IBodyProducer.h"
+#include "AssetCache.h"
 #include "Body.h"
 #include "Plane.h"
-#include "ObjMesh.h"
+#include "BinaryMesh.h"
 #include "util/other.h"
 
 #define PLANE_MODEL "media/models/plane.obj"
@@ -48,6 +49,9 @@ public:
 
     btScalar getMass() const override;
 
+    // loaded on first use
+    static const BinaryMesh &binaryMesh();
+
 protected:
     std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
                                       const btTransform &absoluteTransform) const override;
@@ -0,0 +1,135 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <irrlicht.h>
+#include "Log.h"
+#include "Scoreboard.h"
+#include "util/MappedFile.h"
+
+using namespace irr;
+
+#define SCORE_FILE "scores.bin"
+#define LEGACY_SCORE_FILE "score.txt"
+
+// everything known about a finished run
+// stored as it is, new fields go to the end: records written by older
+//      versions are shorter and their missing fields are zero
+struct RunRecord {
+    s32 score = 0;
+    std::uint32_t duration = 0;         // ms of simulated time
+    std::uint32_t seed = 0;
+    float distance = 0;                 // flown by the plane
+    std::uint32_t obstaclesPassed = 0;
+    std::uint32_t collisions = 0;
+    float averageFrame = 0;             // ms
+    float p99Frame = 0;                 // ms
+    std::uint32_t renderDistance = 0;
+    char build[24] = {};                // see PLAINE_BUILD_ID
+};
+
+// all the runs ever made, kept in an append-only binary log
+//
+// file layout:
+//      header
+//      records, each of them is
+//          size     (uint32, size of the payload)
+//          payload  (RunRecord, or its beginning)
+//          checksum (uint32, FNV-1a of the size and the payload)
+// a record is written at once and flushed, so a crash can only leave
+//      a torn last record, which is detected by its checksum and cut off
+//
+// the best TOP_SIZE runs are indexed in memory, sorted from the best,
+//      the aggregates are kept in memory as well
+class ScoreStore
+{
+public:
+    static constexpr char MAGIC[4] = { 'P', 'L', 'S', 'C' };
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t TOP_SIZE = 1000;
+
+    struct SeedBest {
+        std::uint32_t seed;
+        s32 score;
+        std::size_t runs;
+    };
+
+    // runs with the same render distance and build
+    struct ConfigFrames {
+        std::uint32_t renderDistance;
+        std::string build;
+        std::size_t runs;
+        // percentiles of the average frame times of the runs, ms
+        float p50, p90, p99;
+    };
+
+    // the log is read on the first call, if it doesn't exist
+    //      it's created out of the legacy text scoreboard
+    static ScoreStore &getInstance();
+
+    // returns the place of the run among the best ones, starts with 1,
+    //      it's more than TOP_SIZE if the run isn't one of them
+    std::size_t add(const RunRecord &record);
+
+    // number of runs in the log
+    std::size_t size() const { return m_size; }
+    // up to count best runs starting with the offset-th one
+    std::vector<RunRecord> top(std::size_t offset, std::size_t count) const;
+
+    // seeds played more than once, the most played first
+    std::vector<SeedBest> bestPerSeed(std::size_t count) const;
+    std::vector<ConfigFrames> framesPerConfig() const;
+
+private:
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+    };
+
+    ScoreStore(const std::string &filename, const std::string &legacyFilename);
+
+    // average frame times of the runs with the same configuration,
+    //      sorted up to sorted, the rest is merged in when they're queried
+    struct FrameTimes {
+        std::vector<float> times;
+        std::size_t sorted = 0;
+    };
+
+    // calls f for every valid record and returns the size of the valid part of the file,
+    //      0 if the file is of another format
+    static std::size_t scan(const MappedFile &file, const std::function<void(const RunRecord &)> &f);
+    bool create(const std::vector<s32> &scores);
+    void append(const RunRecord &record);
+    void index(const RunRecord &record);
+
+    std::string m_filename;
+    std::ofstream m_log;
+    std::size_t m_size = 0;
+    std::vector<RunRecord> m_top;
+    std::map<std::uint32_t, SeedBest> m_seeds;
+    mutable std::map<std::pair<std::uint32_t, std::string>, FrameTimes> m_frameTimes;
+};
+
+#endif // SCORESTORE_H
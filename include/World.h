@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
 #include <irrlicht.h>
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
@@ -30,7 +31,9 @@
 #include "Chunk.h"
 #include "Config.h"
 #include "Audio.h"
+#include "CollisionAudio.h"
 #include "Scoreboard.h"
+#include "util/Profiler.h"
 #include "util/options.h"
 
 using namespace irr;
@@ -42,9 +45,13 @@ constexpr btScalar CAMERA_DISTANCE = 200;
 #endif // FAR_CAMERA_DISTANCE
 
 constexpr btScalar EXPLOSION_THRESHOLD = 400.0f;
+// impulse needed to break a compound obstacle apart
+constexpr btScalar BREAK_THRESHOLD = 150.0f;
 
 class World {
     friend struct ContactSensorCallback;
+    friend void checkCollisions(btDynamicsWorld *physicsWorld, btScalar timeStep);
+    friend void substepFinished(btDynamicsWorld *physicsWorld, btScalar timeStep);
 public:
     World(IrrlichtDevice &irrlichtDevice, const ConfigData &configuration, const ChunkDB &chunkDB);
     ~World();
@@ -58,6 +65,13 @@ public:
 
     bool gameOver() const;
     std::size_t obstacles() const;
+    // number of overlapping pairs in the broadphase
+    std::size_t pairs() const;
+    std::size_t obstaclesPassed() const;
+    // contacts of the plane with obstacles
+    std::size_t collisions() const;
+
+    void setCameraDistance(btScalar cameraDistance);
 
     Plane &plane();
 private:
@@ -83,6 +97,15 @@ private:
     scene::ICameraSceneNode &m_camera;
 
     bool m_gameOver = false;
+    std::size_t m_collisions = 0;
+    btScalar m_cameraDistance = CAMERA_DISTANCE;
+
+    CollisionAudio m_collisionAudio;
+
+    // compound obstacles hit hard during the current step
+    std::vector<const btCollisionObject *> m_breaking;
+    // beginning of the current Bullet substep, only set while tracing
+    TraceRecorder::Clock::time_point m_substepStart;
 private:
     void updateCameraAndListener();
 };
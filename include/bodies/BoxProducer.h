@@ -21,6 +21,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <irrlicht.h>
 #include "interfaces/IBodyProducer.h"
+#include "AssetCache.h"
 #include "util/Vector3.h"
 #include "util/constants.h"
 #include "util/options.h"
@@ -45,9 +46,8 @@ protected:
                                 addCubeSceneNode(1));
         node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
         node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
-        node->setScale(bullet2irrlicht(m_halfExtents) * 2);
-        node->setMaterialTexture(0,
-                irrlichtDevice.getVideoDriver()->getTexture("media/textures/square.png"));
+        node->setScale(meshScale());
+        node->setMaterialTexture(0, AssetCache::getInstance().texture(irrlichtDevice, textureName()));
         node->setVisible(TEXTURES_ENABLED);
 #ifdef FOG_ENABLED
             node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
@@ -65,6 +65,22 @@ protected:
         return std::make_unique<btBoxShape>(m_halfExtents);
     }
 
+    scene::IMesh *createMesh(IrrlichtDevice &irrlichtDevice) const override
+    {
+        return irrlichtDevice.getSceneManager()->getGeometryCreator()->
+                createCubeMesh(core::vector3df(1, 1, 1));
+    }
+
+    core::vector3df meshScale() const override
+    {
+        return bullet2irrlicht(m_halfExtents) * 2;
+    }
+
+    io::path textureName() const override
+    {
+        return "media/textures/square.png";
+    }
+
 private:
     btVector3 m_halfExtents;
 };
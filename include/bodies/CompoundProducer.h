@@ -0,0 +1,67 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COMPOUND_PRODUCER
+#define COMPOUND_PRODUCER
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <vector>
+#include <btBulletDynamicsCommon.h>
+#include <irrlicht.h>
+#include "interfaces/IBodyProducer.h"
+#include "Body.h"
+#include "util/other.h"
+#include "util/options.h"
+
+using namespace irr;
+
+// user index of compound bodies, the plane has 1 and other bodies 0
+constexpr int COMPOUND_BODY_INDEX = 2;
+
+// produces several bodies as a single rigid body with a btCompoundShape
+//      and one merged mesh node (one mesh buffer per texture)
+// such a body is broken into its parts with breakApart when hit hard
+class CompoundProducer : public IBodyProducer {
+public:
+    // children's transforms are relative to the pattern;
+    //      the compound body is placed at their centroid
+    CompoundProducer(std::vector<std::unique_ptr<IBodyProducer>> children);
+
+    btScalar getMass() const override;
+
+    // replaces the compound body by its parts keeping its transform and velocity,
+    //      returns number of bodies produced
+    std::size_t breakApart(const Body &compound,
+                           btDynamicsWorld &physicsWorld,
+                           IrrlichtDevice &irrlichtDevice,
+                           std::list<std::unique_ptr<Body>> &list) const;
+
+protected:
+    std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
+                                                  const btTransform &absoluteTransform) const override;
+
+    std::unique_ptr<btCollisionShape> createShape() const override;
+
+    void finishingTouch(btRigidBody &body) const override;
+
+private:
+    std::vector<std::unique_ptr<IBodyProducer>> m_children;
+};
+
+#endif // COMPOUND_PRODUCER
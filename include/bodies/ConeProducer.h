@@ -21,7 +21,8 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionShapes/btConvexPointCloudShape.h>
 #include "interfaces/IBodyProducer.h"
-#include "ObjMesh.h"
+#include "AssetCache.h"
+#include "BinaryMesh.h"
 #include "util/Vector3.h"
 #include "util/constants.h"
 #include "util/options.h"
@@ -32,6 +33,9 @@ using namespace irr;
 
 class ConeProducer : public IBodyProducer {
 public:
+    // loaded on first use, stays in memory until the program ends
+    static const BinaryMesh &binaryMesh();
+
     ConeProducer(btScalar radius, btScalar height) :
         m_radius(radius), m_height(height) {}
 
@@ -46,7 +50,7 @@ protected:
     std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
                                                   const btTransform &absoluteTransform) const override
     {
-        std::unique_ptr<scene::IMesh> mesh(irrlichtDevice.getSceneManager()->getMesh(CONE_MODEL));
+        std::unique_ptr<scene::IMesh> mesh(AssetCache::getInstance().mesh(irrlichtDevice, CONE_MODEL));
 
         std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->
                                     addMeshSceneNode(mesh.release()));
@@ -54,7 +58,7 @@ protected:
         node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
         node->setScale({ m_radius * 2, m_height, m_radius * 2 });
         node->setMaterialTexture(0,
-                 irrlichtDevice.getVideoDriver()->getTexture("media/textures/cone.png"));
+                 AssetCache::getInstance().texture(irrlichtDevice, "media/textures/cone.png"));
         node->setVisible(TEXTURES_ENABLED);
 #ifdef FOG_ENABLED
         node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
@@ -68,7 +72,9 @@ protected:
 
     std::unique_ptr<btCollisionShape> createShape() const override
     {
-        return std::make_unique<btConvexPointCloudShape>(objMesh.getPoints(), objMesh.getPointsCount(),
+        // the shape only reads the points, which stay in the mapped mesh file
+        return std::make_unique<btConvexPointCloudShape>(const_cast<btVector3 *>(binaryMesh().getHullPoints()),
+                                                         binaryMesh().getHullPointsCount(),
                                                          btVector3(m_radius * 2, m_height, m_radius * 2));
     }
 
@@ -76,8 +82,6 @@ protected:
 private:
     const btScalar m_radius;
     const btScalar m_height;
-
-    static ObjMesh &objMesh;
 };
 
 #endif // CONE_PRODUCER
@@ -23,7 +23,8 @@
 #include "BulletCollision/CollisionShapes/btConvexPointCloudShape.h"
 #include <irrlicht.h>
 #include "interfaces/IBodyProducer.h"
-#include "ObjMesh.h"
+#include "AssetCache.h"
+#include "BinaryMesh.h"
 #include "util/Vector3.h"
 #include "util/constants.h"
 #include "util/options.h"
@@ -34,6 +35,9 @@ using namespace irr;
 
 class IcosahedronProducer : public IBodyProducer {
 public:
+    // loaded on first use, stays in memory until the program ends
+    static const BinaryMesh &binaryMesh();
+
     IcosahedronProducer(btScalar edge) :
         m_edge(edge) {}
 
@@ -48,14 +52,14 @@ protected:
     std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
                                                   const btTransform &absoluteTransform) const override
     {
-        std::unique_ptr<scene::IMesh> mesh(irrlichtDevice.getSceneManager()->getMesh(ICOSAHEDRON_MODEL));
+        std::unique_ptr<scene::IMesh> mesh(AssetCache::getInstance().mesh(irrlichtDevice, ICOSAHEDRON_MODEL));
 
         std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->
                                 addMeshSceneNode(mesh.release()));
         node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
         node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
-        node->setScale({ m_edge, m_edge, m_edge });
-        node->setMaterialTexture(0, irrlichtDevice.getVideoDriver()->getTexture("media/textures/icosahedron.png"));
+        node->setScale(meshScale());
+        node->setMaterialTexture(0, AssetCache::getInstance().texture(irrlichtDevice, textureName()));
         node->setVisible(TEXTURES_ENABLED);
 #ifdef FOG_ENABLED
         node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
@@ -69,15 +73,33 @@ protected:
 
     std::unique_ptr<btCollisionShape> createShape() const override
     {
-        return std::make_unique<btConvexPointCloudShape>(objMesh.getPoints(), objMesh.getPointsCount(),
+        // the shape only reads the points, which stay in the mapped mesh file
+        return std::make_unique<btConvexPointCloudShape>(const_cast<btVector3 *>(binaryMesh().getHullPoints()),
+                                                         binaryMesh().getHullPointsCount(),
                                                          btVector3(m_edge, m_edge, m_edge));
     }
 
+    scene::IMesh *createMesh(IrrlichtDevice &irrlichtDevice) const override
+    {
+        scene::IMesh *mesh = AssetCache::getInstance().mesh(irrlichtDevice, ICOSAHEDRON_MODEL);
+        if (mesh)
+            mesh->grab();
+
+        return mesh;
+    }
+
+    core::vector3df meshScale() const override
+    {
+        return { m_edge, m_edge, m_edge };
+    }
+
+    io::path textureName() const override
+    {
+        return "media/textures/icosahedron.png";
+    }
 
 private:
     const btScalar m_edge;
-
-    static ObjMesh &objMesh;
 };
 
 #endif // ICOSAHEDRON_PRODUCER
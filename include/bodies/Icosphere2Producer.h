@@ -21,7 +21,8 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionShapes/btConvexPointCloudShape.h>
 #include "interfaces/IBodyProducer.h"
-#include "ObjMesh.h"
+#include "AssetCache.h"
+#include "BinaryMesh.h"
 #include "util/Vector3.h"
 #include "util/constants.h"
 #include "util/options.h"
@@ -32,6 +33,9 @@ using namespace irr;
 
 class Icosphere2Producer : public IBodyProducer {
 public:
+    // loaded on first use, stays in memory until the program ends
+    static const BinaryMesh &binaryMesh();
+
     Icosphere2Producer(btScalar radius) :
         m_radius(radius) {}
 
@@ -46,14 +50,14 @@ protected:
     std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
                                                   const btTransform &absoluteTransform) const override
     {
-        std::unique_ptr<scene::IMesh> mesh(irrlichtDevice.getSceneManager()->getMesh(ICOSPHERE2_MODEL));
+        std::unique_ptr<scene::IMesh> mesh(AssetCache::getInstance().mesh(irrlichtDevice, ICOSPHERE2_MODEL));
 
         std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->
                                 addMeshSceneNode(mesh.release()));
         node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
         node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
         node->setScale(core::vector3df(m_radius, m_radius, m_radius) * 2);
-        node->setMaterialTexture(0, irrlichtDevice.getVideoDriver()->getTexture("media/textures/icosphere2.png"));
+        node->setMaterialTexture(0, AssetCache::getInstance().texture(irrlichtDevice, "media/textures/icosphere2.png"));
         node->setVisible(TEXTURES_ENABLED);
 #if LOG_ENABLED
         node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
@@ -67,15 +71,15 @@ protected:
 
     std::unique_ptr<btCollisionShape> createShape() const override
     {
-        return std::make_unique<btConvexPointCloudShape>(objMesh.getPoints(), objMesh.getPointsCount(),
+        // the shape only reads the points, which stay in the mapped mesh file
+        return std::make_unique<btConvexPointCloudShape>(const_cast<btVector3 *>(binaryMesh().getHullPoints()),
+                                                         binaryMesh().getHullPointsCount(),
                                                          btVector3(m_radius, m_radius, m_radius) * 2);
     }
 
 
 private:
     const btScalar m_radius;
-
-    static ObjMesh &objMesh;
 };
 
 #endif // ICOSPHERE2_PRODUCER
@@ -22,7 +22,8 @@
 #include <BulletCollision/CollisionShapes/btConvexPointCloudShape.h>
 #include <irrlicht.h>
 #include "interfaces/IBodyProducer.h"
-#include "ObjMesh.h"
+#include "AssetCache.h"
+#include "BinaryMesh.h"
 #include "util/Vector3.h"
 #include "util/constants.h"
 #include "util/options.h"
@@ -33,6 +34,9 @@ using namespace irr;
 
 class TetrahedronProducer : public IBodyProducer {
 public:
+    // loaded on first use, stays in memory until the program ends
+    static const BinaryMesh &binaryMesh();
+
     TetrahedronProducer(btScalar edge) :
         m_edge(edge) {}
 
@@ -46,14 +50,14 @@ public:
     std::unique_ptr<scene::ISceneNode> createNode(IrrlichtDevice &irrlichtDevice,
                                                   const btTransform &absoluteTransform) const override
     {
-        std::unique_ptr<scene::IMesh> mesh(irrlichtDevice.getSceneManager()->getMesh(TETRAHEDRON_MODEL));
+        std::unique_ptr<scene::IMesh> mesh(AssetCache::getInstance().mesh(irrlichtDevice, TETRAHEDRON_MODEL));
 
         std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->
                            addMeshSceneNode(mesh.release()));
         node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
         node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
         node->setScale({ m_edge, m_edge, m_edge });
-        node->setMaterialTexture(0, irrlichtDevice.getVideoDriver()->getTexture("media/textures/tetrahedron.png"));
+        node->setMaterialTexture(0, AssetCache::getInstance().texture(irrlichtDevice, "media/textures/tetrahedron.png"));
         node->setVisible(TEXTURES_ENABLED);
 #if FOG_ENABLED
         node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
@@ -67,14 +71,14 @@ public:
 
     std::unique_ptr<btCollisionShape> createShape() const override
     {
-        return std::make_unique<btConvexPointCloudShape>(objMesh.getPoints(), objMesh.getPointsCount(),
+        // the shape only reads the points, which stay in the mapped mesh file
+        return std::make_unique<btConvexPointCloudShape>(const_cast<btVector3 *>(binaryMesh().getHullPoints()),
+                                                         binaryMesh().getHullPointsCount(),
                                                          btVector3(1, 1, 1) * m_edge);
     }
 
 private:
     const btScalar m_edge;
-
-    static ObjMesh &objMesh;
 };
 
 #endif // TETRAHEDRON_PRODUCER
@@ -99,10 +99,15 @@ private:
 
     s32 buttonWidth, buttonHeight;
 
+    // selected element shown in brackets and its text without them
+    gui::IGUIElement *bracketedElement = nullptr;
+    core::stringw bracketedText;
+
     ConfigData &configuration;
     gui::IGUIEnvironment &guiEnvironment;
 
     void updateSelection();
+    void removeBrackets();
     void recalculateButtonProportions();
 };
 
@@ -0,0 +1,88 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TEXTBINDING_H
+#define TEXTBINDING_H
+
+#include <array>
+#include <cstddef>
+#include <cwchar>
+#include <string>
+#include <irrlicht.h>
+#include "util/i18n.h"
+
+using namespace irr;
+
+// translation of a gettext message, looked up in the cache only when the language changes
+class TranslatedLabel
+{
+public:
+    explicit TranslatedLabel(const char *msgid) :
+        m_msgid(msgid) {}
+
+    const wchar_t *get();
+
+private:
+    const char *m_msgid;
+    unsigned m_generation = 0;
+    const wchar_t *m_text = nullptr;
+};
+
+// text of a static text element that is formatted into a fixed buffer
+//      and set only if it differs from the displayed one
+// nothing has to be formatted while the element is hidden, see active()
+class TextBinding
+{
+public:
+    static constexpr std::size_t SIZE = 512;
+
+    void bind(gui::IGUIStaticText *element);
+    bool active() const;
+
+    // starts a new text
+    void clear();
+    // swprintf format, wide strings are %ls
+    template <typename... Args>
+    void append(const wchar_t *format, Args... args)
+    {
+        if (m_length >= SIZE - 1)
+            return;
+
+        const int written = std::swprintf(m_buffer.data() + m_length, SIZE - m_length, format, args...);
+        // swprintf fails if the text doesn't fit, the text is cut then
+        m_length = written < 0 ? SIZE - 1 : m_length + written;
+        m_buffer[m_length] = L'\0';
+    }
+    // passes the text to the element if it changed
+    void commit();
+
+    template <typename... Args>
+    void set(const wchar_t *format, Args... args)
+    {
+        clear();
+        append(format, args...);
+        commit();
+    }
+
+private:
+    gui::IGUIStaticText *m_element = nullptr;
+    std::array<wchar_t, SIZE> m_buffer {};
+    std::array<wchar_t, SIZE> m_shown {};
+    std::size_t m_length = 0;
+};
+
+#endif // TEXTBINDING_H
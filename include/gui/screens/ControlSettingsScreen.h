@@ -23,6 +23,7 @@
 #include "Config.h"
 #include "util/i18n.h"
 #include "gui/GUIID.h"
+#include "gui/TextBinding.h"
 
 using namespace irr;
 
@@ -47,6 +48,10 @@ public:
     gui::IGUIButton *buttonDefaultControls;
     gui::IGUIButton *buttonSettings;
     gui::IGUIButton *buttonQuit;
+
+    // textScreenSize is updated through this
+    TextBinding screenSize;
+    TranslatedLabel labelScreenSize { "Screen size: " };
 };
 
 #endif // CONTROLSETTINGSSCREEN_H
@@ -23,6 +23,7 @@
 #include "Plane.h"
 #include "util/i18n.h"
 #include "gui/GUIID.h"
+#include "gui/TextBinding.h"
 
 using namespace irr;
 
@@ -44,6 +45,10 @@ public:
     gui::IGUIStaticText *textMessage;
     gui::IGUIStaticText *textScore;
     gui::IGUIButton *buttonOK;
+
+    // textScore is updated through this
+    TextBinding score;
+    TranslatedLabel labelScore { "Your score: " };
 };
 
 #endif // GAMEOVERSCREEN_H
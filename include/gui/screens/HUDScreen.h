@@ -22,6 +22,10 @@
 #include "Config.h"
 #include "util/i18n.h"
 #include "gui/GUIID.h"
+#include "gui/TextBinding.h"
+#include "util/MemoryStats.h"
+#include "util/Profiler.h"
+#include "util/options.h"
 
 using namespace irr;
 
@@ -51,6 +55,28 @@ public:
     gui::IGUIStaticText *textVelocity;
     gui::IGUIStaticText *textAngle;
     gui::IGUIStaticText *textScore;
+    gui::IGUIStaticText *textProfiler;
+    gui::IGUIStaticText *textMemory;
+
+    // the texts above are updated through these
+    TextBinding cameraPosition;
+    TextBinding obstaclesCount;
+    TextBinding fps;
+    TextBinding velocity;
+    TextBinding angle;
+    TextBinding score;
+    TextBinding profiler;
+
+    TranslatedLabel labelPosition { "Plane position: (" };
+    TranslatedLabel labelObstacles { "Obstacles: " };
+    TranslatedLabel labelFPS { "FPS: " };
+    TranslatedLabel labelLinearVelocity { "Linear velocity: " };
+    TranslatedLabel labelAngularVelocity { "; Angular velocity: " };
+    TranslatedLabel labelPitch { "Pitch: " };
+    TranslatedLabel labelYaw { "°; Yaw: " };
+    TranslatedLabel labelRoll { "°; Roll: " };
+    TranslatedLabel labelDegree { "°" };
+    TranslatedLabel labelScore { "Score: " };
 };
 
 #endif // HUDSCREEN_H
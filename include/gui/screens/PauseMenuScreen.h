@@ -22,6 +22,7 @@
 #include "Config.h"
 #include "util/i18n.h"
 #include "gui/GUIID.h"
+#include "gui/TextBinding.h"
 
 using namespace irr;
 
@@ -43,6 +44,10 @@ public:
     gui::IGUIButton *buttonResume;
     gui::IGUIButton *buttonMenu;
     gui::IGUIButton *buttonQuit;
+
+    // textScreenSize is updated through this
+    TextBinding screenSize;
+    TranslatedLabel labelScreenSize { "Screen size: " };
 };
 
 #endif // PAUSEMENUSCREEN_H
@@ -21,7 +21,7 @@
 #include <irrlicht.h>
 #include <interfaces/IGUIScreen.h>
 #include "Config.h"
-#include "Scoreboard.h"
+#include "ScoreStore.h"
 #include "gui/GUIID.h"
 #include "util/i18n.h"
 
@@ -31,6 +31,11 @@ class ScoreboardScreen : public IGUIScreen
 {
     bool initialized = false;
 
+    // rows shown in the table, the rest of the scores is never read
+    static constexpr std::size_t PAGE_SIZE = 100;
+    // seeds and configurations shown under the table
+    static constexpr std::size_t STATISTICS_LINES = 6;
+
 public:
     ScoreboardScreen(const ConfigData &configuration, gui::IGUIEnvironment &guiEnvironment);
     ~ScoreboardScreen();
@@ -43,6 +48,7 @@ public:
     virtual void setVisible(bool visible) override;
 
     gui::IGUITable *tableScore;
+    gui::IGUIStaticText *textStatistics;
     gui::IGUIButton *buttonMenu;
     gui::IGUIButton *buttonQuit;
 };
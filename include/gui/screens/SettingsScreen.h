@@ -22,6 +22,7 @@
 #include "Config.h"
 #include "util/i18n.h"
 #include "gui/GUIID.h"
+#include "gui/TextBinding.h"
 
 using namespace irr;
 
@@ -55,6 +56,10 @@ public:
     gui::IGUIButton *buttonControlSettings;
     gui::IGUIButton *buttonMenu;
     gui::IGUIButton *buttonQuit;
+
+    // textScreenSize is updated through this
+    TextBinding screenSize;
+    TranslatedLabel labelScreenSize { "Screen size: " };
 };
 
 #endif // SETTINGSSCREEN_H
@@ -24,12 +24,28 @@
 #include "Body.h"
 #include "util/Vector3.h"
 #include "util/other.h"
+#include "util/MemoryStats.h"
 
 using namespace irr;
 
 class IBodyProducer {
+    friend class CompoundProducer;
 public:
     IBodyProducer() = default;
+    virtual ~IBodyProducer() = default;
+
+    // producers live in ChunkDB, count them (only the objects, see MemoryCategory)
+    static void *operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MemoryCategory::PRODUCERS, size);
+        return ::operator new(size);
+    }
+
+    static void operator delete(void *pointer, std::size_t size)
+    {
+        MemoryStats::freed(MemoryCategory::PRODUCERS, size);
+        ::operator delete(pointer);
+    }
 
     virtual std::unique_ptr<Body> produce(btDynamicsWorld &physicsWorld,
                                           IrrlichtDevice &irrlichtDeivce,
@@ -69,6 +85,12 @@ protected:
     virtual std::unique_ptr<btCollisionShape> createShape() const = 0;
 
     virtual void finishingTouch(btRigidBody &/* body */) const {}
+
+    // body's render mesh in its local space, used to merge several bodies into one node
+    // the returned mesh is grabbed; nullptr means the body can't be merged
+    virtual scene::IMesh *createMesh(IrrlichtDevice &/* irrlichtDevice */) const { return nullptr; }
+    virtual core::vector3df meshScale() const { return { 1, 1, 1 }; }
+    virtual io::path textureName() const { return ""; }
 };
 
 #endif // IBODY_PRODUCER
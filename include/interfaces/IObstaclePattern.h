@@ -40,6 +40,9 @@ public:
     // in Chunk to create bodies
     virtual std::vector<std::unique_ptr<IBodyProducer>> producers() const = 0;
 
+    // whether producers should be merged into one compound body
+    virtual bool compound() const { return false; }
+
 private:
     const int m_id;
 };
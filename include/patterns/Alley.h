@@ -22,6 +22,7 @@
 #include "interfaces/IObstaclePattern.h"
 #include "bodies/IcosahedronProducer.h"
 #include "util/other.h"
+#include "util/options.h"
 
 template <int Length>
 class Alley : public IObstaclePattern
@@ -74,5 +75,9 @@ public:
         return result;
     }
 
+    bool compound() const override
+    {
+        return COMPOUND_PATTERNS;
+    }
 };
 #endif // VALLEY_H
@@ -22,6 +22,7 @@
 #include "interfaces/IObstaclePattern.h"
 #include "bodies/BoxProducer.h"
 #include "util/other.h"
+#include "util/options.h"
 
 using namespace irr;
 
@@ -60,6 +61,11 @@ public:
 
         return result;
     }
+
+    bool compound() const override
+    {
+        return COMPOUND_PATTERNS;
+    }
 };
 
 #endif // TUNNEL_H
@@ -346,6 +346,28 @@ namespace gui
 			//! \param page_index Simply return the texture handle of a given page index.
 			video::ITexture* getPageTextureByIndex(u32 page_index) const;
 
+			//! Returns the number of glyph pages.
+			u32 getPageCount() const { return GlyphPages.size(); }
+
+			//! Returns the memory taken by the glyph page textures.
+			u32 getPageTextureBytes() const;
+
+			//! Loads the glyphs of the given characters and uploads the glyph pages once,
+			//! so the first text using them doesn't update the textures while drawing.
+			//! \param characters Zero-terminated string of the characters to load.
+			void prewarm(const wchar_t* characters);
+
+			//! Starts collecting the glyphs of the following draw calls instead of drawing them.
+			//! Only for texts which don't overlap each other, as they're drawn after everything
+			//! else drawn until endBatch(). Clipping is applied to each glyph on the CPU.
+			void beginBatch();
+
+			//! Draws the glyphs collected since beginBatch(), one call per glyph page and color.
+			void endBatch();
+
+			//! Returns whether draw calls are being collected.
+			bool isBatching() const { return Batching; }
+
 		protected:
 			//! Create a new glyph page texture.
 			//! \param pixel_mode the pixel mode defined by FT_Pixel_Mode
@@ -413,6 +435,25 @@ namespace gui
 			s32 GlobalKerningWidth;
 			s32 GlobalKerningHeight;
 			core::stringw Invisible;
+
+			// Glyphs of one page and color collected while batching.
+			struct SBatchRun
+			{
+				CGUITTGlyphPage* Page;
+				video::SColor Color;
+				bool Outline;
+				core::array<core::vector2di> Positions;
+				core::array<core::recti> SourceRects;
+			};
+
+			void batchGlyphs(CGUITTGlyphPage* page, video::SColor color, bool outline,
+				const core::array<core::vector2di>& positions, const core::array<core::recti>& sourceRects,
+				const core::rect<s32>* clip);
+
+			bool Batching;
+			// Runs are kept between batches so their arrays don't reallocate, only the first BatchRunCount are used.
+			core::array<SBatchRun> BatchRuns;
+			u32 BatchRunCount;
 	};
 
 } // end namespace gui
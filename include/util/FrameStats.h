@@ -0,0 +1,69 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "util/Profiler.h"
+
+// rolling histogram of frame times with a hitch detector
+// a frame taking more than HITCH_FACTOR medians (and MIN_HITCH) is a hitch: the stage
+//      timings and obstacle counts of the frames around it go to the log
+class FrameStats {
+public:
+    static constexpr std::size_t WINDOW = 600;    // frames in the histogram
+    static constexpr std::size_t BUCKETS = 128;   // 1 ms each, the last one holds longer frames
+    static constexpr std::size_t CONTEXT = 5;     // frames logged before and after a hitch
+    static constexpr std::size_t MIN_FRAMES = 60; // frames needed to detect hitches
+    static constexpr float HITCH_FACTOR = 2.0f;
+    static constexpr float MIN_HITCH = 20.0f;     // ms, shorter frames aren't noticeable
+
+    FrameStats();
+
+    // takes the timings of the frame just finished from Profiler
+    void addFrame(std::size_t obstacles);
+
+    // p in [0; 1], ms
+    float percentile(float p) const;
+    float median() const { return percentile(0.5f); }
+
+    std::size_t frames() const { return m_frames; }
+    std::size_t hitches() const { return m_hitches; }
+
+private:
+    struct Frame {
+        std::array<float, STAGE_COUNT> stages;
+        std::size_t obstacles;
+    };
+
+    static std::size_t bucket(float milliseconds);
+    void dump(std::size_t hitch) const;
+
+    std::array<Frame, WINDOW> m_window;
+    std::array<std::uint32_t, BUCKETS> m_histogram;
+    std::size_t m_frames = 0;
+    std::size_t m_hitches = 0;
+
+    static constexpr std::size_t NO_HITCH = -1;
+    std::size_t m_pendingHitch = NO_HITCH; // waits for the frames after it
+    float m_pendingMedian = 0;
+};
+
+#endif // FRAMESTATS_H
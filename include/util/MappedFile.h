@@ -0,0 +1,61 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+#include <utility>
+
+#ifdef _WIN32
+#  include <Windows.h>
+#endif
+
+// read-only memory mapping of a whole file
+// the contents are paged in by the OS on first access,
+//      so opening even a big file is almost free
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator =(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator =(const MappedFile &) = delete;
+
+    bool open(const std::string &filename);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif // _WIN32
+};
+
+#endif // MAPPEDFILE_H
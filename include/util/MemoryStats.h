@@ -0,0 +1,74 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include "util/options.h"
+
+// memory counted by MemoryStats
+// BULLET is everything Bullet allocates (the world, rigid bodies, shapes),
+//      PRODUCERS the body producer objects kept in the chunk DB
+//      and BODIES the Body objects of live obstacles
+// PRODUCERS and BODIES are the objects themselves (their number times their size):
+//      the Bullet objects they own are in BULLET, their containers
+//      and scene nodes aren't counted
+enum class MemoryCategory { BULLET, PRODUCERS, BODIES, COUNT };
+
+constexpr std::size_t MEMORY_CATEGORY_COUNT = static_cast<std::size_t>(MemoryCategory::COUNT);
+
+class MemoryStats {
+public:
+    MemoryStats() = delete;
+
+    struct Snapshot {
+        std::array<std::size_t, MEMORY_CATEGORY_COUNT> bytes;       // allocated at the moment
+        std::array<std::size_t, MEMORY_CATEGORY_COUNT> allocations; // since the start
+    };
+
+    static void allocated(MemoryCategory category, std::size_t size)
+    {
+#if MEMORY_STATS_ENABLED
+        const std::size_t i = static_cast<std::size_t>(category);
+        bytes[i].fetch_add(size, std::memory_order_relaxed);
+        allocations[i].fetch_add(1, std::memory_order_relaxed);
+#endif // MEMORY_STATS_ENABLED
+    }
+
+    static void freed(MemoryCategory category, std::size_t size)
+    {
+#if MEMORY_STATS_ENABLED
+        bytes[static_cast<std::size_t>(category)].fetch_sub(size, std::memory_order_relaxed);
+#endif // MEMORY_STATS_ENABLED
+    }
+
+    static Snapshot snapshot();
+    static const char *categoryName(MemoryCategory category);
+
+    // makes Bullet allocate through counting functions
+    // must be called before Bullet allocates anything
+    static void installBulletHooks();
+
+private:
+    static std::array<std::atomic<std::size_t>, MEMORY_CATEGORY_COUNT> bytes;
+    static std::array<std::atomic<std::size_t>, MEMORY_CATEGORY_COUNT> allocations;
+};
+
+#endif // MEMORYSTATS_H
@@ -0,0 +1,98 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include "util/TraceRecorder.h"
+#include "util/options.h"
+
+// stages of a frame measured by ScopedTimer
+// COLLISIONS is a part of SIMULATION, FRAME is measured between endFrame calls
+enum class Stage { INPUT, GENERATION, SIMULATION, COLLISIONS,
+                   RENDER_SYNC, SCENE_DRAW, GUI_DRAW, FRAME, COUNT };
+
+constexpr std::size_t STAGE_COUNT = static_cast<std::size_t>(Stage::COUNT);
+
+// collects per-frame stage timings of the main thread
+//      and keeps the last WINDOW frames of them
+class Profiler {
+    Profiler();
+
+public:
+    using Clock = TraceRecorder::Clock;
+
+    static constexpr std::size_t WINDOW = 240; // frames
+
+    struct Summary {
+        float min = 0; // all in milliseconds
+        float avg = 0;
+        float p99 = 0;
+    };
+
+    static Profiler &getInstance();
+    static const char *stageName(Stage stage);
+
+    // adds time spent in a stage during the current frame
+    void add(Stage stage, Clock::duration duration);
+    void endFrame();
+    // drops the current frame, e.g. one spent in a menu
+    void discardFrame();
+
+    // time a stage took during the last finished frame, ms
+    float last(Stage stage) const;
+    Summary summary(Stage stage) const;
+    std::size_t frames() const;
+
+private:
+    std::array<Clock::duration, STAGE_COUNT> m_current;
+    std::array<std::array<float, WINDOW>, STAGE_COUNT> m_history;
+    std::size_t m_frames = 0;
+    Clock::time_point m_frameStart;
+};
+
+// adds its lifetime to a stage and to the trace if it's being recorded
+class ScopedTimer {
+public:
+#if PROFILER_ENABLED
+    ScopedTimer(Stage stage) :
+        m_stage(stage), m_start(Profiler::Clock::now()) {}
+
+    ~ScopedTimer()
+    {
+        const Profiler::Clock::time_point end = Profiler::Clock::now();
+        Profiler::getInstance().add(m_stage, end - m_start);
+        TraceRecorder::getInstance().complete(Profiler::stageName(m_stage), m_start, end);
+    }
+#else
+    ScopedTimer(Stage) {}
+#endif // PROFILER_ENABLED
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator =(const ScopedTimer &) = delete;
+
+#if PROFILER_ENABLED
+private:
+    const Stage m_stage;
+    const Profiler::Clock::time_point m_start;
+#endif // PROFILER_ENABLED
+};
+
+#endif // PROFILER_H
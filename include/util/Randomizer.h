@@ -49,8 +49,16 @@ public:
     {
         return getReal<float>(min, max);
     }
+
+    // seeds the calling thread's engine
+    static void seed(std::default_random_engine::result_type value)
+    {
+        engine.seed(value);
+    }
 private:
-    static std::default_random_engine engine;
+    // every thread has its own engine, so that seeded generation
+    //      doesn't depend on other threads
+    static thread_local std::default_random_engine engine;
 };
 
 #endif // RANDOMIZER_H
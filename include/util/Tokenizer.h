@@ -0,0 +1,67 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstddef>
+#include <string>
+
+struct Token {
+    enum Type { INT, FLOAT, STRING, KEYWORD, OP_EQUAL, OP_COMMA, OP_COLON, OP_SHARP, NEWLINE, END, INVALID };
+
+    Type type = END;
+    // points into the buffer, strings are without the quotes
+    const char *text = nullptr;
+    std::size_t length = 0;
+    long intValue = 0;
+    float floatValue = 0;
+
+    bool is(const char *keyword) const;
+    std::string string() const { return std::string(text, length); }
+
+    static const char *typeName(Type type);
+};
+
+// splits a text buffer (usually a mapped file) into tokens in a single pass
+//      without copying anything
+//
+// keywords start with a letter and consist of letters and digits,
+//      numbers are decimal and may be negative, strings are in double quotes
+//      and can't contain quotes or line breaks
+class Tokenizer
+{
+public:
+    Tokenizer(const char *begin, const char *end) :
+        m_position(begin), m_end(end) {}
+
+    Token next();
+    // skips everything up to the end of the line including the line break,
+    //      does nothing if the last token was a line break
+    void skipLine();
+
+    // number of the line of the last token, starts with 1
+    std::size_t line() const { return m_line; }
+
+private:
+    const char *m_position;
+    const char *m_end;
+    std::size_t m_line = 1;
+    bool m_newLine = false;
+};
+
+#endif // TOKENIZER_H
@@ -0,0 +1,120 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+const std::string TRACE_FILE { "trace.json" };
+
+// records timeline events of all threads while recording is on
+//      and writes them in Chrome Trace Event format
+//      (opened by chrome://tracing and ui.perfetto.dev)
+// every thread appends to its own buffer,
+//      a buffer is released when its thread exits and its events are written
+class TraceRecorder {
+    TraceRecorder();
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+    static TraceRecorder &getInstance();
+
+    void start();
+    // stops recording and writes the events recorded since start
+    bool stop(const std::string &filename = TRACE_FILE);
+
+    bool recording() const { return m_recording.load(std::memory_order_relaxed); }
+
+    // adds an event lasting from begin to end,
+    //      name must be a string literal, count is shown if not negative
+    void complete(const char *name, Clock::time_point begin, Clock::time_point end, long count = -1);
+
+    // names the calling thread in the trace
+    void setThreadName(const std::string &name);
+
+private:
+    struct Event {
+        const char *name;
+        Clock::time_point begin;
+        Clock::time_point end;
+        long count;
+    };
+
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<Event> events;
+        std::string name;
+        std::size_t id;
+        bool released = false; // its thread has exited
+    };
+
+    // releases the buffer of its thread on thread exit
+    struct BufferOwner {
+        ThreadBuffer *buffer = nullptr;
+        ~BufferOwner();
+    };
+
+    ThreadBuffer &threadBuffer();
+
+    std::atomic<bool> m_recording { false };
+    const Clock::time_point m_epoch;
+    std::atomic<std::size_t> m_dropped { 0 };
+
+    std::mutex m_mutex; // guards m_buffers and m_nextId
+    std::list<ThreadBuffer> m_buffers;
+    std::size_t m_nextId = 1;
+};
+
+// records its lifetime if recording is on
+class TraceScope {
+public:
+    TraceScope(const char *name, long count = -1) :
+        m_name(name), m_count(count),
+        m_recording(TraceRecorder::getInstance().recording())
+    {
+        if (m_recording)
+            m_begin = TraceRecorder::Clock::now();
+    }
+
+    ~TraceScope()
+    {
+        if (m_recording)
+            TraceRecorder::getInstance().complete(m_name, m_begin, TraceRecorder::Clock::now(), m_count);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator =(const TraceScope &) = delete;
+
+    void setCount(long count) { m_count = count; }
+
+private:
+    const char *m_name;
+    long m_count;
+    const bool m_recording;
+    TraceRecorder::Clock::time_point m_begin;
+};
+
+#endif // TRACERECORDER_H
@@ -21,26 +21,32 @@
 #include <libintl.h>
 #include <irrlicht.h>
 
-#ifndef _WIN32
-#  include <iconv.h>
-#else
+#ifdef _WIN32
 #  include <Windows.h>
 #endif
 
 using namespace irr;
 
 #define _(string) gettext(string)
-#define _w(string) utf8_to_irrwide(gettext(string))
-#define _wp(string) utf8_to_wide(gettext(string)).c_str()
+#define _w(string) core::stringw(translate(string))
+#define _wp(string) translate(string)
+
+// translation of the message in the current language, converted once per language
+// for a literal msgid the pointer stays valid until the end of the program
+// only for the main thread
+const wchar_t *translate(const char *msgid);
 
-std::size_t convert(const char *to, const char *from,
-                    char *outbuf, std::size_t outbuf_size,
-                    char *inbuf, std::size_t inbuf_size);
 std::wstring utf8_to_wide(const std::string &input);
 core::stringw utf8_to_irrwide(const std::string &input);
 std::string wide_to_utf8(const std::wstring &input);
 
+// every distinct character used by the translations of the language's catalogue
+//      (media/locale/<language>/LC_MESSAGES/planerunner.mo), empty if there's none
+std::wstring catalogueCharacters(const std::string &language);
+
 core::stringw keyCodeName(const EKEY_CODE &keyCode);
 void setLanguage(const std::string &language, bool replace);
+// changes every time the language is set, starts with 1
+unsigned languageGeneration();
 
 #endif // GETTEXT_H
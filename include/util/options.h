@@ -50,10 +50,41 @@
     #define DEBUG_OUTPUT false
 #endif // DEBUG_OUTPUT
 
+// the most verbose severity written to the log:
+//      0 error, 1 warning, 2 notice, 3 info, 4 debug
+// calls below it are compiled out
+#ifndef LOG_LEVEL
+    #if DEBUG_OUTPUT
+        #define LOG_LEVEL 4
+    #else
+        #define LOG_LEVEL 3
+    #endif // DEBUG_OUTPUT
+#endif // LOG_LEVEL
+
 #ifndef FAR_CAMERA_DISTANCE
     #define FAR_CAMERA_DISTANCE false
 #endif // FAR_CAMERA_DISTANCE
 
+// per-frame stage timings shown on the F3 overlay
+#ifndef PROFILER_ENABLED
+    #define PROFILER_ENABLED true
+#endif // PROFILER_ENABLED
+
+// per-subsystem memory usage shown on the F3 overlay and in the log
+#ifndef MEMORY_STATS_ENABLED
+    #define MEMORY_STATS_ENABLED true
+#endif // MEMORY_STATS_ENABLED
+
+// produce multi-part patterns (tunnels, alleys) as single compound bodies
+#ifndef COMPOUND_PATTERNS
+    #define COMPOUND_PATTERNS true
+#endif // COMPOUND_PATTERNS
+
 #ifndef NAN_ASSERT
     #define NAN_ASSERT false
 #endif // NAN_ASSERT
+
+// identifies the build in perf results and run records, set by CMake from git describe
+#ifndef PLAINE_BUILD_ID
+    #define PLAINE_BUILD_ID "unknown"
+#endif // PLAINE_BUILD_ID
@@ -17,17 +17,64 @@
 #include <clocale>
 #include <random>
 #include <exception>
+#include <iostream>
+#include <string>
 #include <irrlicht.h>
 
 #include "Game.h"
 #include "Config.h"
 #include "Log.h"
+#include "util/MemoryStats.h"
 #include "util/i18n.h"
 
 using namespace irr;
 
-int main()
+static void usage()
 {
+    std::cerr << "usage: PlaneRunner [--record FILE] [--replay FILE [--headless]] [--perf FILE [--replay FILE]] [--perf-text FILE]" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+#if MEMORY_STATS_ENABLED
+    // before anything is allocated by Bullet
+    MemoryStats::installBulletHooks();
+#endif // MEMORY_STATS_ENABLED
+
+    std::string recordingFile, replayFile, perfFile, perfTextFile;
+    bool headless = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+
+        if (arg == "--record" && i + 1 < argc)
+            recordingFile = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayFile = argv[++i];
+        else if (arg == "--perf" && i + 1 < argc)
+            perfFile = argv[++i];
+        else if (arg == "--perf-text" && i + 1 < argc)
+            perfTextFile = argv[++i];
+        else if (arg == "--headless")
+            headless = true;
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    // perf scenarios are always run without a window, texts always with one
+    if (!perfFile.empty() && !perfTextFile.empty()) {
+        usage();
+        return 1;
+    }
+    if (!perfFile.empty())
+        headless = true;
+    else if (headless && (replayFile.empty() || !perfTextFile.empty())) {
+        usage();
+        return 1;
+    }
+
     // load config into the structure (conf file is kept in the root directory of the project)
     ConfigData data = Config::loadConfig("game.conf");
     // setting language (platform dependent realization!)
@@ -41,7 +88,17 @@ int main()
 
     // create instance of game class and give it configuration structure
     try {
-        Game(data).start();
+        Game game(data, headless ? video::EDT_NULL : video::EDT_OPENGL);
+
+        if (!perfFile.empty())
+            return game.perf(perfFile, replayFile) ? 0 : 1;
+        if (!perfTextFile.empty())
+            return game.perfText(perfTextFile) ? 0 : 1;
+        if (!replayFile.empty())
+            return game.replay(replayFile) ? 0 : 1;
+
+        game.setRecordingFile(recordingFile);
+        game.start();
     } catch (const std::exception &e) {
         Log::getInstance().error(e.what());
 
@@ -0,0 +1,150 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include "AssetCache.h"
+
+AssetCache &AssetCache::getInstance()
+{
+    static AssetCache instance;
+
+    return instance;
+}
+
+AssetCache::~AssetCache()
+{
+    clear();
+}
+
+video::ITexture *AssetCache::texture(IrrlichtDevice &device, const io::path &filename)
+{
+    video::IVideoDriver &driver = *device.getVideoDriver();
+    if (video::ITexture *texture = driver.findTexture(filename))
+        return texture;
+
+    video::IImage *&image = m_images[filename.c_str()];
+    if (!image) {
+        image = driver.createImageFromFile(filename);
+        if (!image) {
+            Log::getInstance().warning("unable to load texture \"", filename.c_str(), "\".");
+            m_images.erase(filename.c_str());
+            return nullptr;
+        }
+    }
+
+    return driver.addTexture(filename, image);
+}
+
+video::ITexture *AssetCache::atlas(IrrlichtDevice &device, const io::path &name,
+                                   const std::vector<io::path> &filenames, std::vector<core::recti> &rects)
+{
+    video::IVideoDriver &driver = *device.getVideoDriver();
+
+    if (m_atlasRects.find(name.c_str()) == m_atlasRects.end()) {
+        // only the atlas is kept, the images it's made of aren't needed anymore
+        std::vector<video::IImage *> images;
+        core::dimension2du size(0, 0);
+        for (const io::path &filename : filenames) {
+            video::IImage *image = driver.createImageFromFile(filename);
+            if (!image) {
+                Log::getInstance().warning("unable to load texture \"", filename.c_str(), "\".");
+                for (video::IImage *loaded : images)
+                    loaded->drop();
+                return nullptr;
+            }
+
+            images.push_back(image);
+            size.Width = std::max(size.Width, image->getDimension().Width);
+            size.Height += image->getDimension().Height + 1;
+        }
+
+        // the images are stacked in a column with a transparent row between them,
+        //      so filtering never mixes two of them
+        video::IImage *atlas = driver.createImage(video::ECF_A8R8G8B8, size.getOptimalSize());
+        atlas->fill(video::SColor(0, 0, 0, 0));
+
+        std::vector<core::recti> &atlasRects = m_atlasRects[name.c_str()];
+        s32 top = 0;
+        for (video::IImage *image : images) {
+            image->copyTo(atlas, core::position2di(0, top));
+            atlasRects.emplace_back(core::position2di(0, top), image->getDimension());
+            top += image->getDimension().Height + 1;
+            image->drop();
+        }
+
+        video::IImage *&cached = m_images[name.c_str()];
+        if (cached)
+            cached->drop();
+        cached = atlas;
+    }
+
+    rects = m_atlasRects[name.c_str()];
+    return texture(device, name);
+}
+
+scene::IAnimatedMesh *AssetCache::mesh(IrrlichtDevice &device, const io::path &filename)
+{
+    scene::IMeshCache &meshCache = *device.getSceneManager()->getMeshCache();
+    if (scene::IAnimatedMesh *mesh = meshCache.getMeshByName(filename))
+        return mesh;
+
+    scene::IAnimatedMesh *&mesh = m_meshes[filename.c_str()];
+    if (!mesh) {
+        // loading adds it to the mesh cache too
+        mesh = device.getSceneManager()->getMesh(filename);
+        if (!mesh) {
+            Log::getInstance().warning("unable to load mesh \"", filename.c_str(), "\".");
+            m_meshes.erase(filename.c_str());
+            return nullptr;
+        }
+        mesh->grab();
+
+        return mesh;
+    }
+
+    meshCache.addMesh(filename, mesh);
+    return mesh;
+}
+
+float AssetCache::restore(IrrlichtDevice &device)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto &image : m_images)
+        texture(device, image.first.c_str());
+    for (const auto &mesh : m_meshes)
+        AssetCache::mesh(device, mesh.first.c_str());
+
+    const float time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!m_images.empty() || !m_meshes.empty())
+        Log::getInstance().info("restored ", m_images.size(), " textures and ", m_meshes.size(),
+                                " meshes in ", time, " ms");
+
+    return time;
+}
+
+void AssetCache::clear()
+{
+    for (const auto &image : m_images)
+        image.second->drop();
+    for (const auto &mesh : m_meshes)
+        mesh.second->drop();
+
+    m_images.clear();
+    m_meshes.clear();
+    m_atlasRects.clear();
+}
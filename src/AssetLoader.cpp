@@ -0,0 +1,73 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <thread>
+#include "AssetLoader.h"
+#include "Audio.h"
+#include "Patterns.h"
+#include "PlaneProducer.h"
+#include "ScoreStore.h"
+#include "bodies/ConeProducer.h"
+#include "bodies/IcosahedronProducer.h"
+#include "bodies/Icosphere2Producer.h"
+#include "bodies/TetrahedronProducer.h"
+#include "util/TraceRecorder.h"
+
+std::vector<AssetLoader::Asset> AssetLoader::assets()
+{
+    return {
+        { "sounds",             [] { Audio::getInstance(); } },
+        { "plane mesh",         [] { PlaneProducer::binaryMesh(); } },
+        { "cone mesh",          [] { ConeProducer::binaryMesh(); } },
+        { "icosahedron mesh",   [] { IcosahedronProducer::binaryMesh(); } },
+        { "icosphere mesh",     [] { Icosphere2Producer::binaryMesh(); } },
+        { "tetrahedron mesh",   [] { TetrahedronProducer::binaryMesh(); } },
+        { "patterns",           [] { Patterns::all(); } },
+        { "scores",             [] { ScoreStore::getInstance(); } }
+    };
+}
+
+float AssetLoader::loadAll()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point start = Clock::now();
+    const std::vector<Asset> all = assets();
+    std::vector<float> times(all.size());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < all.size(); i++)
+        threads.emplace_back([&all, &times, i]
+        {
+            TraceScope trace(all[i].name);
+            const Clock::time_point assetStart = Clock::now();
+            all[i].load();
+            times[i] = std::chrono::duration<float, std::milli>(Clock::now() - assetStart).count();
+        });
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (std::size_t i = 0; i < all.size(); i++)
+        Log::getInstance().info("loaded ", all[i].name, " in ", times[i], " ms");
+
+    const float total = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    Log::getInstance().notice("assets loaded in ", total, " ms");
+
+    return total;
+}
@@ -14,10 +14,15 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include "Audio.h"
 
-Audio Audio::instance;
-std::queue<sf::Sound, std::list<sf::Sound>> Audio::queue;
+Audio &Audio::getInstance()
+{
+    static Audio instance;
+
+    return instance;
+}
 
 Audio::Audio() {
     if (!collisionBuffer.loadFromFile(COLLISION_FILE))
@@ -25,59 +30,102 @@ Audio::Audio() {
 
     if (!explosionBuffer.loadFromFile(EXPLOSION_FILE))
         Log::getInstance().warning("couldn't open file '", EXPLOSION_FILE, "'");
+}
+
+sf::Music &Audio::music(Track track)
+{
+    std::unique_ptr<sf::Music> &music = tracks[static_cast<std::size_t>(track)];
+    if (!music) {
+        const char *filename = track == Track::MENU ? MENU_FILE : BACKGROUND_FILE;
 
-    if (!backgroundBuffer.loadFromFile(BACKGROUND_FILE))
-        Log::getInstance().warning("couldn't open file '", BACKGROUND_FILE, "'");
+        music = std::make_unique<sf::Music>();
+        if (!music->openFromFile(filename))
+            Log::getInstance().warning("couldn't open file '", filename, "'");
+    }
 
-    if (!menuBuffer.loadFromFile(MENU_FILE))
-        Log::getInstance().warning("couldn't open file '", MENU_FILE, "'");
+    return *music;
 }
 
-sf::Sound Audio::collision() const
+std::size_t Audio::bufferBytes() const
 {
-    return sf::Sound(collisionBuffer);
+    return (collisionBuffer.getSampleCount() + explosionBuffer.getSampleCount()) * sizeof(sf::Int16);
 }
 
-sf::Sound Audio::explosion() const
+const sf::SoundBuffer &Audio::buffer(Effect effect) const
 {
-    return sf::Sound(explosionBuffer);
+    switch (effect) {
+    case Effect::EXPLOSION:
+        return explosionBuffer;
+    case Effect::COLLISION:
+    default:
+        return collisionBuffer;
+    }
 }
 
-sf::Sound Audio::background() const
+Audio::Voice *Audio::acquireVoice(Effect effect, float volume)
 {
-    return sf::Sound(backgroundBuffer);
+    Voice *victim = nullptr;
+
+    for (Voice &voice : voices) {
+        if (voice.sound.getStatus() == sf::SoundSource::Stopped)
+            return &voice;
+
+        if (!victim || voice.effect < victim->effect ||
+                (voice.effect == victim->effect && voice.volume < victim->volume))
+            victim = &voice;
+    }
+
+    // never steal a voice from a more important sound
+    if (victim->effect > effect || (victim->effect == effect && victim->volume > volume)) {
+        m_dropped++;
+        return nullptr;
+    }
+
+    victim->sound.stop();
+    return victim;
 }
 
-sf::Sound Audio::menu() const
+Audio::Voice *Audio::prepareVoice(Effect effect, float volume)
 {
-    return sf::Sound(menuBuffer);
+    Voice *voice = acquireVoice(effect, volume);
+    if (!voice)
+        return nullptr;
+
+    voice->effect = effect;
+    voice->volume = volume;
+    // setting a buffer registers the sound in it, which allocates
+    if (voice->sound.getBuffer() != &buffer(effect))
+        voice->sound.setBuffer(buffer(effect));
+    voice->sound.setVolume(volume);
+
+    return voice;
 }
 
-void Audio::play(sf::Sound sound, float volume)
+void Audio::play(Effect effect, float volume)
 {
-    if (volume >= 0)
-        sound.setVolume(volume);
-
-    queue.push(sound);
-    queue.back().play();
+    Voice *voice = prepareVoice(effect, volume);
+    if (!voice)
+        return;
 
-    clearQueue();
+    voice->sound.setRelativeToListener(true);
+    voice->sound.setPosition(0, 0, 0);
+    voice->sound.play();
 }
 
-void Audio::playAt(sf::Sound sound, const Vector3<float> &position, float volume)
+void Audio::playAt(Effect effect, const Vector3<float> &position, float volume)
 {
-    sound.setPosition(position);
-    if (volume >= 0)
-        sound.setVolume(volume);
-
-    queue.push(sound);
-    queue.back().play();
+    Voice *voice = prepareVoice(effect, volume);
+    if (!voice)
+        return;
 
-    clearQueue();
+    voice->sound.setRelativeToListener(false);
+    voice->sound.setPosition(position);
+    voice->sound.play();
 }
 
-void Audio::clearQueue()
+std::size_t Audio::playing(Effect effect) const
 {
-    while (queue.front().getStatus() == sf::SoundSource::Stopped)
-        queue.pop();
+    return std::count_if(voices.begin(), voices.end(), [effect](const Voice &voice) {
+        return voice.effect == effect && voice.sound.getStatus() != sf::SoundSource::Stopped;
+    });
 }
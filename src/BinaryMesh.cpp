@@ -0,0 +1,169 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryMesh.h"
+
+constexpr char BinaryMesh::MAGIC[4];
+constexpr std::uint32_t BinaryMesh::VERSION;
+
+BinaryMesh::BinaryMesh(const std::string &objFilename)
+{
+    if (!loadBinary(binaryFilename(objFilename))) {
+        Log::getInstance().notice("no valid binary mesh for \"", objFilename, "\", parsing the model.");
+        loadObj(objFilename);
+    }
+}
+
+std::string BinaryMesh::binaryFilename(const std::string &objFilename)
+{
+    std::string::size_type dot = objFilename.rfind('.');
+    if (dot == std::string::npos || objFilename.find('/', dot) != std::string::npos)
+        return objFilename + ".mesh";
+
+    return objFilename.substr(0, dot) + ".mesh";
+}
+
+bool BinaryMesh::loadBinary(const std::string &filename)
+{
+    if (!m_file.open(filename))
+        return false;
+
+    if (m_file.size() < sizeof(Header)) {
+        Log::getInstance().warning("binary mesh \"", filename, "\" is truncated.");
+        m_file.close();
+        return false;
+    }
+
+    const Header &header = *reinterpret_cast<const Header *>(m_file.data());
+    if (!std::equal(header.magic, header.magic + 4, MAGIC) ||
+        header.version != VERSION || header.scalarSize != sizeof(btScalar))
+    {
+        Log::getInstance().warning("binary mesh \"", filename, "\" is of an incompatible format.");
+        m_file.close();
+        return false;
+    }
+
+    // 64-bit so that counts from a corrupted header can't wrap around
+    const std::uint64_t expectedSize = sizeof(Header) +
+            (static_cast<std::uint64_t>(header.vertexCount) + header.hullCount) * sizeof(btVector3) +
+            static_cast<std::uint64_t>(header.indexCount) * sizeof(std::uint32_t);
+    if (m_file.size() < expectedSize) {
+        Log::getInstance().warning("binary mesh \"", filename, "\" is truncated.");
+        m_file.close();
+        return false;
+    }
+
+    const char *data = m_file.data() + sizeof(Header);
+
+    m_vertices = reinterpret_cast<const btVector3 *>(data);
+    m_vertexCount = header.vertexCount;
+    data += m_vertexCount * sizeof(btVector3);
+
+    m_hull = reinterpret_cast<const btVector3 *>(data);
+    m_hullCount = header.hullCount;
+    data += m_hullCount * sizeof(btVector3);
+
+    m_indices = reinterpret_cast<const std::uint32_t *>(data);
+    m_indexCount = header.indexCount;
+
+    if (std::any_of(m_indices, m_indices + m_indexCount,
+                    [this](std::uint32_t index) { return index >= m_vertexCount; }))
+    {
+        Log::getInstance().warning("binary mesh \"", filename, "\" has an index out of range.");
+        m_file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void BinaryMesh::loadObj(const std::string &filename)
+{
+    ObjMesh objMesh(filename);
+
+    m_objVertices = objMesh.getVertices();
+    m_objHull = hullPoints(m_objVertices);
+    m_objIndices = objMesh.getTriangleIndices();
+
+    m_vertices = m_objVertices.data();
+    m_vertexCount = m_objVertices.size();
+    m_hull = m_objHull.data();
+    m_hullCount = m_objHull.size();
+    m_indices = m_objIndices.data();
+    m_indexCount = m_objIndices.size();
+}
+
+bool BinaryMesh::save(const std::string &filename, const ObjMesh &objMesh)
+{
+    const std::vector<btVector3> &vertices = objMesh.getVertices();
+    const std::vector<btVector3> hull = hullPoints(vertices);
+    const std::vector<std::uint32_t> indices = objMesh.getTriangleIndices();
+
+    std::ofstream outputFile(filename, std::ios::binary);
+    if (!outputFile.is_open()) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for writing.");
+        return false;
+    }
+
+    Header header {};
+    std::copy(MAGIC, MAGIC + 4, header.magic);
+    header.version = VERSION;
+    header.scalarSize = sizeof(btScalar);
+    header.vertexCount = vertices.size();
+    header.hullCount = hull.size();
+    header.indexCount = indices.size();
+
+    outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    outputFile.write(reinterpret_cast<const char *>(vertices.data()), vertices.size() * sizeof(btVector3));
+    outputFile.write(reinterpret_cast<const char *>(hull.data()), hull.size() * sizeof(btVector3));
+    outputFile.write(reinterpret_cast<const char *>(indices.data()), indices.size() * sizeof(std::uint32_t));
+
+    return static_cast<bool>(outputFile);
+}
+
+std::unique_ptr<btTriangleMesh> BinaryMesh::getTriangleMesh(btScalar scale) const
+{
+    auto triangleMesh = std::make_unique<btTriangleMesh>();
+    for (std::size_t i = 0; i + 2 < m_indexCount; i += 3)
+        triangleMesh->addTriangle(m_vertices[m_indices[i]] * scale,
+                                  m_vertices[m_indices[i + 1]] * scale,
+                                  m_vertices[m_indices[i + 2]] * scale);
+
+    return triangleMesh;
+}
+
+// btShapeHull samples the support function in a fixed set of directions
+//      and keeps only the points it hits, so the result is the hull
+//      without inner and coplanar vertices (slightly simplified for
+//      round meshes), which makes GJK support queries cheaper
+std::vector<btVector3> BinaryMesh::hullPoints(const std::vector<btVector3> &vertices)
+{
+    if (vertices.empty())
+        return {};
+
+    btConvexHullShape shape(&vertices[0].x(), vertices.size(), sizeof(btVector3));
+    // margin would inflate every support point
+    shape.setMargin(0);
+
+    btShapeHull shapeHull(&shape);
+    if (!shapeHull.buildHull(0) || shapeHull.numVertices() == 0) {
+        Log::getInstance().warning("failed to build a convex hull, using all the vertices.");
+        return vertices;
+    }
+
+    return std::vector<btVector3>(shapeHull.getVertexPointer(),
+                                  shapeHull.getVertexPointer() + shapeHull.numVertices());
+}
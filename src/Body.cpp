@@ -16,10 +16,27 @@
 
 #include "Body.h"
 
+// compound shapes don't own their children
+static void deleteShape(btCollisionShape *shape)
+{
+    if (shape && shape->isCompound()) {
+        auto *compound = static_cast<btCompoundShape *>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); i++)
+            deleteShape(compound->getChildShape(i));
+    }
+
+    delete shape;
+}
+
 Body::~Body()
 {
-    if (m_rigidBody)
+    if (m_rigidBody) {
         m_physicsWorld.removeCollisionObject(m_rigidBody.get());
+
+        // the rigid body doesn't own its motion state (and so the node) and shape
+        delete m_rigidBody->getMotionState();
+        deleteShape(m_rigidBody->getCollisionShape());
+    }
 }
 
 scene::ISceneNode &Body::node()
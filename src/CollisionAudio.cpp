@@ -0,0 +1,87 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include "CollisionAudio.h"
+
+CollisionAudio::CollisionAudio()
+{
+    m_pending.reserve(64);
+    m_played.reserve(64);
+}
+
+bool CollisionAudio::sameSource(const Event &a, const Event &b) const
+{
+    return (a.objA == b.objA && a.objB == b.objB) ||
+            (a.cell[0] == b.cell[0] && a.cell[1] == b.cell[1] && a.cell[2] == b.cell[2]);
+}
+
+void CollisionAudio::add(const btCollisionObject *objA, const btCollisionObject *objB,
+                         const btVector3 &position, btScalar impulse)
+{
+    // the order of the pair doesn't matter
+    if (objB < objA)
+        std::swap(objA, objB);
+
+    Event event { objA, objB,
+                  { static_cast<std::int32_t>(std::floor(position.x() / CELL_SIZE)),
+                    static_cast<std::int32_t>(std::floor(position.y() / CELL_SIZE)),
+                    static_cast<std::int32_t>(std::floor(position.z() / CELL_SIZE)) },
+                  position * impulse, impulse, 0 };
+
+    for (Event &pending : m_pending)
+        if (sameSource(pending, event)) {
+            pending.position += event.position;
+            pending.impulse += impulse;
+            return;
+        }
+
+    m_pending.push_back(event);
+}
+
+void CollisionAudio::flush(btScalar timeStep)
+{
+    m_time += timeStep;
+    m_played.erase(std::remove_if(m_played.begin(), m_played.end(),
+                                  [this](const Event &event) { return m_time - event.time > WINDOW; }),
+                   m_played.end());
+
+    // the loudest events get the voices
+    std::sort(m_pending.begin(), m_pending.end(),
+              [](const Event &a, const Event &b) { return a.impulse > b.impulse; });
+
+    Audio &audio = Audio::getInstance();
+    std::size_t voices = audio.playing(Effect::COLLISION);
+    for (Event &event : m_pending) {
+        if (voices >= MAX_VOICES)
+            break;
+
+        if (std::any_of(m_played.begin(), m_played.end(),
+                        [this, &event](const Event &played) { return sameSource(played, event); }))
+            continue;
+
+        const btScalar volume = std::min(btScalar(1), event.impulse / FULL_VOLUME_IMPULSE) * 100;
+        audio.playAt(Effect::COLLISION, event.position / event.impulse, volume);
+        voices++;
+
+        event.time = m_time;
+        m_played.push_back(event);
+    }
+
+    m_pending.clear();
+}
@@ -14,406 +14,198 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include "Config.h"
 
 using namespace irr;
 
-// parses the file into items like string, numbers etc.
-// uses a simple deterministic finite automaton
-std::vector<Config::Item> Config::parse(const std::string &filename)
-{
-    std::ifstream inputFile(filename);
-    if (!inputFile.is_open()) {
-        Log::getInstance().warning("unable to open file\"", filename, "\" for reading.");
-        return std::vector<Item>();
-    }
+// a boolean option stored in a ConfigData member
+#define BOOL_OPTION(_name, _member) \
+    { _name, nullptr, Option::BOOL, 0, 1, \
+      [](ConfigData &data, const Value &value) { data._member = value.first != 0; }, \
+      [](const ConfigData &data) { Value value; value.first = data._member; return value; } }
 
-    std::vector<Item> items;
-    std::string str;
-    int back = 0;
+// KEY_KEY_CODES_COUNT marks an unbound control
+#define KEY_OPTION(_name, _control) \
+    { _name, "controls", Option::KEY, 0, KEY_KEY_CODES_COUNT, \
+      [](ConfigData &data, const Value &value) { data.controls[_control] = (EKEY_CODE) value.first; }, \
+      [](const ConfigData &data) { Value value; value.first = data.controls[_control]; return value; } }
 
-    enum { NONE, INT, FLOAT, STRING, KEYWORD } state = NONE;
-    while (inputFile) {
-        int c = back ? back : inputFile.get();
-        back = 0;
-        switch (state) {
-        case NONE:
-            if (c == '\n') {
-                items.push_back(Item(Item::NEWLINE));
-            } else if (c == '=') {
-                items.push_back(Item(Item::OP_EQUAL));
-            } else if (c == ',') {
-                items.push_back(Item(Item::OP_COMMA));
-            } else if (c == ':') {
-                items.push_back(Item(Item::OP_COLON));
-            } else if (isspace(c)) {
-                // nothing
-            } else if (c == '"') {
-                state = STRING;
-            } else if (isalpha(c)) {
-                str.push_back(c);
-                state = KEYWORD;
-            } else if (isdigit(c)) {
-                str.push_back(c);
-                state = INT;
-            } else if (c == EOF) {
-                break;
-            } else {
-                Log::getInstance().warning("config \"", filename, "\" is invalid.");
-                return std::vector<Item>();
-            }
-            break;
+const std::vector<Config::Option> &Config::schema()
+{
+    static const std::vector<Option> options = {
+        { "resolution", nullptr, Option::RESOLUTION, 1, 1 << 16,
+          [](ConfigData &data, const Value &value) {
+              data.resolution = core::dimension2d<u32>(value.first, value.second);
+          },
+          [](const ConfigData &data) {
+              Value value;
+              value.first = data.resolution.Width;
+              value.second = data.resolution.Height;
+              return value;
+          } },
+        BOOL_OPTION("fullscreen", fullscreen),
+        { "volume", nullptr, Option::INT, 0, 100,
+          [](ConfigData &data, const Value &value) { data.volume = value.first; },
+          [](const ConfigData &data) { Value value; value.first = data.volume; return value; } },
+        { "language", nullptr, Option::STRING, 0, 0,
+          [](ConfigData &data, const Value &value) { data.language = value.string; },
+          [](const ConfigData &data) { Value value; value.string = data.language; return value; } },
+        BOOL_OPTION("resizable", resizable),
+        BOOL_OPTION("vsync", vsync),
+        BOOL_OPTION("stencilbuffer", stencilBuffer),
+        { "renderdistance", nullptr, Option::INT, 1, std::numeric_limits<s32>::max(),
+          [](ConfigData &data, const Value &value) { data.renderDistance = value.first; },
+          [](const ConfigData &data) { Value value; value.first = data.renderDistance; return value; } },
+        { "menufps", nullptr, Option::INT, 0, 1000,
+          [](ConfigData &data, const Value &value) { data.menuFPS = value.first; },
+          [](const ConfigData &data) { Value value; value.first = data.menuFPS; return value; } },
+        KEY_OPTION("up", CONTROL::UP),
+        KEY_OPTION("left", CONTROL::LEFT),
+        KEY_OPTION("down", CONTROL::DOWN),
+        KEY_OPTION("right", CONTROL::RIGHT),
+        KEY_OPTION("clockwiseroll", CONTROL::CW_ROLL),
+        KEY_OPTION("counterclockwiseroll", CONTROL::CCW_ROLL)
+    };
+
+    return options;
+}
 
-        case INT:
-            if (isdigit(c)) {
-                str.push_back(c);
-            } else if (c == '.') {
-                str.append(localeconv()->decimal_point);
-                state = FLOAT;
-            } else {
-                back = c;
-                items.push_back(Item(Item::INT, (s32) std::stoi(str)));
-                str.clear();
-                state = NONE;
-            }
-            break;
+#undef BOOL_OPTION
+#undef KEY_OPTION
 
-        case FLOAT:
-            if (isdigit(c)) {
-                str.push_back(c);
-            } else {
-                back = c;
-                items.push_back(Item(Item::FLOAT, (f32) stof(str)));
-                str.clear();
-                state = NONE;
-            }
+// takes the next token and complains if it's not the expected one
+static bool expect(Tokenizer &tokenizer, Token::Type expected, Token &token)
+{
+    token = tokenizer.next();
+    if (token.type == expected)
+        return true;
 
-        case STRING:
-            if (c == '"') {
-                items.push_back(Item(Item::STRING, str));
-                str.clear();
-                state = NONE;
-            } else {
-                str.push_back(c);
-            }
-            break;
+    Log::getInstance().warning(Token::typeName(expected), " expected, but ",
+                               Token::typeName(token.type), " found in line ", tokenizer.line(), ".");
+    return false;
+}
 
-        case KEYWORD:
-            if (isalnum(c)) {
-                str.push_back(c);
-            } else {
-                back = c;
-                items.push_back(Item(Item::KEYWORD, str));
-                str.clear();
-                state = NONE;
-            }
-            break;
-        }
-    }
+static bool expectInt(Tokenizer &tokenizer, long min, long max, long &result)
+{
+    Token token;
+    if (!expect(tokenizer, Token::INT, token))
+        return false;
 
-    if (items.back().type != Item::NEWLINE)
-        items.push_back(Item(Item::NEWLINE));
+    if (token.intValue < min || token.intValue > max) {
+        Log::getInstance().warning("value in line ", tokenizer.line(), " must be from ", min, " to ", max, ".");
+        return false;
+    }
 
-    return items;
+    result = token.intValue;
+    return true;
 }
 
-void Config::warning(Item::ItemType expected, Item::ItemType found)
+// reads the value of the option and the end of the line
+static bool parseValue(Tokenizer &tokenizer, const Config::Option &option, Config::Value &value)
 {
-    Log::getInstance().warning(Item::typeToString(expected), " expected, but ",
-                 Item::typeToString(found), " found.");
-}
+    Token token;
+
+    switch (option.type) {
+    case Config::Option::BOOL:
+        if (!expect(tokenizer, Token::KEYWORD, token))
+            return false;
+        if (!token.is("on") && !token.is("off")) {
+            Log::getInstance().warning("on or off expected, but ", token.string(),
+                                       " found in line ", tokenizer.line(), ".");
+            return false;
+        }
+        value.first = token.is("on");
+        break;
+    case Config::Option::INT:
+    case Config::Option::KEY:
+        if (!expectInt(tokenizer, option.min, option.max, value.first))
+            return false;
+        break;
+    case Config::Option::STRING:
+        if (!expect(tokenizer, Token::STRING, token))
+            return false;
+        value.string = token.string();
+        break;
+    case Config::Option::RESOLUTION:
+        if (!expectInt(tokenizer, option.min, option.max, value.first) ||
+                !expect(tokenizer, Token::OP_COMMA, token) ||
+                !expectInt(tokenizer, option.min, option.max, value.second))
+            return false;
+        break;
+    }
+
+    token = tokenizer.next();
+    if (token.type != Token::NEWLINE && token.type != Token::END) {
+        Log::getInstance().warning(Token::typeName(Token::NEWLINE), " expected, but ",
+                                   Token::typeName(token.type), " found in line ", tokenizer.line(), ".");
+        return false;
+    }
 
-// throws an error if we encounter something we don't want
-#define \
-EXPECT(_expected) {\
-    if (i->type != _expected) {\
-        warning(_expected, i->type);\
-        goToNextNEWLINE = true;\
-        state = NONE;\
-        break;\
-    }\
+    return true;
 }
 
-// loads configuration infotmation from file
-// uses another simple deterministic finit automaton
+// loads configuration information from file
+// the file is mapped and parsed in one pass, invalid lines are skipped
 ConfigData Config::loadConfig(const std::string &filename)
 {
     ConfigData data;
 
-    std::vector<Item> items = parse(filename);
-
-    // print items (for debug purposes)
-    /* for (const Item &item : items) {
-        if (item.type == Item::INT)
-            std::cout << "INT: " << (int) item.getInt() << std::endl;
-        else if (item.type == Item::FLOAT)
-            std::cout << "FLOAT: " << (float) item.getFloat() << std::endl;
-        else if (item.type == Item::STRING)
-            std::cout << "STRING: '" << item.getString() << "'" << std::endl;
-        else if (item.type == Item::KEYWORD)
-            std::cout << "KEYWORD: " << item.getString() << std::endl;
-        else if (item.type == Item::OP_EQUAL)
-            std::cout << "OP_EQUAL" << std::endl;
-        else if (item.type == Item::OP_COMMA)
-            std::cout << "OP_COMMA" << std::endl;
-        else if (item.type == Item::NEWLINE)
-            std::cout << "NEWLINE" << std::endl;
-    } */
-
-    bool goToNextNEWLINE = false;
-    enum { NONE, RESOLUTION, FULLSCREEN, VOLUME, LANGUAGE, RESIZABLE, VSYNC, STENCILBUFFER, RENDER_DISTANCE, CONTROLS,
-    CONTROL_UP, CONTROL_LEFT, CONTROL_DOWN, CONTROL_RIGHT, CONTROL_CW_ROLL, CONTROL_CCW_ROLL} state = NONE;
-
-    for (std::vector<Item>::const_iterator i = items.cbegin(); i != items.cend(); ++i) {
-        if (goToNextNEWLINE) {
-            if (i->type == Item::NEWLINE)
-                goToNextNEWLINE = false;
-        } else {
-            switch (state) {
-            case NONE:
-                EXPECT(Item::KEYWORD);
-
-                if (i->getString() == "resolution")
-                    state = RESOLUTION;
-                else if (i->getString() == "fullscreen")
-                    state = FULLSCREEN;
-		else if (i->getString() == "volume") {
-  		    state = VOLUME;
-                } else if (i->getString() == "language")
-                    state = LANGUAGE;
-                else if (i->getString() == "resizable")
-                    state = RESIZABLE;
-                else if (i->getString() == "vsync")
-                    state = VSYNC;
-                else if (i->getString() == "stencilbuffer")
-                    state = STENCILBUFFER;
-                else if (i->getString() == "renderdistance")
-                    state = RENDER_DISTANCE;
-                else if (i->getString() == "controls")
-                    state = CONTROLS;
-                else if (i->getString() == "up")
-                    state = CONTROL_UP;
-                else if (i->getString() == "left")
-                    state = CONTROL_LEFT;
-                else if (i->getString() == "down")
-                    state = CONTROL_DOWN;
-                else if (i->getString() == "right")
-                    state = CONTROL_RIGHT;
-                else if (i->getString() == "clockwiseroll")
-                    state = CONTROL_CW_ROLL;
-                else if (i->getString() == "counterclockwiseroll")
-                    state = CONTROL_CCW_ROLL;
-                break;
-            case RESOLUTION: {
-                core::dimension2d<u32> resolution;
-
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-                EXPECT(Item::INT);
-                resolution.Width = i->getInt();
-                ++i;
-                EXPECT(Item::OP_COMMA);
-                ++i;
-                EXPECT(Item::INT);
-                resolution.Height = i->getInt();
-                data.resolution = resolution;
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case FULLSCREEN: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::KEYWORD);
-                if (i->getString() != "on" && i->getString() != "off") {
-                    Log::getInstance().warning("on or off expected, but ", Item::typeToString(i -> type), " found.");
-                    goToNextNEWLINE = true;
-                    break;
-                }
-                data.fullscreen = i->getString() == "on";
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-	    case VOLUME: {
-  	        EXPECT(Item::OP_EQUAL);
-		++i;
-
-		EXPECT(Item::INT);
-		data.volume = i->getInt();
-		++i;
-		EXPECT(Item::NEWLINE);
-
-		state = NONE;
-		break;
-	    }
-            case LANGUAGE: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::STRING);
-                data.language = "";
-                std::string str = i->getString();
-                for (std::string::const_iterator si = str.cbegin(); si != str.cend(); ++si)
-                    data.language.push_back(*si);
-
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case RESIZABLE: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::KEYWORD);
-                if (i->getString() != "on" && i->getString() != "off") {
-                    Log::getInstance().warning("on or off expected, but ", Item::typeToString(i->type), " found.");
-                    goToNextNEWLINE = true;
-                    break;
-                }
-                data.resizable = i->getString() == "on";
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case VSYNC: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::KEYWORD);
-                if (i->getString() != "on" && i->getString() != "off") {
-                    Log::getInstance().warning("on or off expected, but ", Item::typeToString(i->type), " found.");
-                    goToNextNEWLINE = true;
-                    break;
-                }
-                data.vsync = i->getString() == "on";
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case STENCILBUFFER: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::KEYWORD);
-                if (i->getString() != "on" && i->getString() != "off") {
-                    Log::getInstance().warning("on or off expected, but ", Item::typeToString(i->type), " found.");
-                    goToNextNEWLINE = true;
-                    break;
-                }
-                data.stencilBuffer = i->getString() == "on";
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case RENDER_DISTANCE: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::INT);
-                data.renderDistance = i->getInt();
-                ++i;
-
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case CONTROLS: {
-                EXPECT(Item::OP_COLON);
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case CONTROL_UP: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::INT);
-                data.controls[CONTROL::UP] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case CONTROL_LEFT: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::INT);
-                data.controls[CONTROL::LEFT] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case CONTROL_DOWN: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
-
-                EXPECT(Item::INT);
-                data.controls[CONTROL::DOWN] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
-
-                state = NONE;
-                break;
-            }
-            case CONTROL_RIGHT: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
+    MappedFile file;
+    if (!file.open(filename)) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for reading.");
+        return data;
+    }
 
-                EXPECT(Item::INT);
-                data.controls[CONTROL::RIGHT] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
+    const std::vector<Option> &options = schema();
+    Tokenizer tokenizer(file.data(), file.data() + file.size());
+    std::string section; // options before the first section have none
 
-                state = NONE;
-                break;
-            }
-            case CONTROL_CW_ROLL: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
+    for (Token token = tokenizer.next(); token.type != Token::END; token = tokenizer.next()) {
+        if (token.type == Token::NEWLINE)
+            continue;
 
-                EXPECT(Item::INT);
-                data.controls[CONTROL::CW_ROLL] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
+        Token next;
+        if (token.type != Token::KEYWORD || (next = tokenizer.next()).type == Token::INVALID) {
+            Log::getInstance().warning("config \"", filename, "\" is invalid in line ", tokenizer.line(), ".");
+            tokenizer.skipLine();
+            continue;
+        }
 
-                state = NONE;
-                break;
-            }
-            case CONTROL_CCW_ROLL: {
-                EXPECT(Item::OP_EQUAL);
-                ++i;
+        // beginning of a section
+        if (next.type == Token::OP_COLON) {
+            section = token.string();
+            if (std::none_of(options.begin(), options.end(),
+                             [&token](const Option &option) { return option.section && token.is(option.section); }))
+                Log::getInstance().warning("unknown section \"", token.string(), "\" in line ", tokenizer.line(), ".");
+            tokenizer.skipLine();
+            continue;
+        }
 
-                EXPECT(Item::INT);
-                data.controls[CONTROL::CCW_ROLL] = (EKEY_CODE)i->getInt();
-                ++i;
-                EXPECT(Item::NEWLINE);
+        if (next.type != Token::OP_EQUAL) {
+            Log::getInstance().warning(Token::typeName(Token::OP_EQUAL), " expected, but ",
+                                       Token::typeName(next.type), " found in line ", tokenizer.line(), ".");
+            tokenizer.skipLine();
+            continue;
+        }
 
-                state = NONE;
-                break;
-            }
-            }
+        auto option = std::find_if(options.begin(), options.end(), [&token, &section](const Option &option) {
+            return token.is(option.name) && section == (option.section ? option.section : "");
+        });
+        if (option == options.end()) {
+            Log::getInstance().warning("unknown option \"", token.string(), "\" in line ", tokenizer.line(), ".");
+            tokenizer.skipLine();
+            continue;
         }
+
+        Value value;
+        if (parseValue(tokenizer, *option, value))
+            option->set(data, value);
+        else
+            tokenizer.skipLine();
     }
 
     return data;
@@ -429,19 +221,33 @@ void Config::saveConfig(const std::string &filename, const ConfigData &data)
         return;
     }
 
-    outputFile << "resolution=" << data.resolution.Width << "," << data.resolution.Height << std::endl;
-    outputFile << "fullscreen=" << (data.fullscreen ? "on" : "off") << std::endl;
-    outputFile << "volume=" << data.volume << std::endl;
-    outputFile << "language=" << "\"" << std::string(data.language.c_str()) << "\"" << std::endl;
-    outputFile << "resizable=" << (data.resizable ? "on" : "off") << std::endl;
-    outputFile << "vsync=" << (data.vsync ? "on" : "off") << std::endl;
-    outputFile << "stencilbuffer=" << (data.stencilBuffer ? "on" : "off") << std::endl;
-    outputFile << "renderdistance=" << data.renderDistance << std::endl;
-    outputFile << "controls:" << std::endl;
-    outputFile << "    up=" << data.controls[CONTROL::UP] << std::endl;
-    outputFile << "    left=" << data.controls[CONTROL::LEFT] << std::endl;
-    outputFile << "    down=" << data.controls[CONTROL::DOWN] << std::endl;
-    outputFile << "    right=" << data.controls[CONTROL::RIGHT] << std::endl;
-    outputFile << "    clockwiseroll=" << data.controls[CONTROL::CW_ROLL] << std::endl;
-    outputFile << "    counterclockwiseroll=" << data.controls[CONTROL::CCW_ROLL] << std::endl;
+    const char *section = nullptr;
+    for (const Option &option : schema()) {
+        // sections are compared by name, the same literal may have several copies
+        if ((option.section == nullptr) != (section == nullptr) ||
+                (section && std::strcmp(option.section, section) != 0)) {
+            section = option.section;
+            if (section)
+                outputFile << section << ":" << std::endl;
+        }
+
+        const Value value = option.get(data);
+        outputFile << (section ? "    " : "") << option.name << "=";
+        switch (option.type) {
+        case Option::BOOL:
+            outputFile << (value.first ? "on" : "off");
+            break;
+        case Option::INT:
+        case Option::KEY:
+            outputFile << value.first;
+            break;
+        case Option::STRING:
+            outputFile << "\"" << value.string << "\"";
+            break;
+        case Option::RESOLUTION:
+            outputFile << value.first << "," << value.second;
+            break;
+        }
+        outputFile << std::endl;
+    }
 }
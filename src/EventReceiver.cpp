@@ -27,6 +27,11 @@ EventReceiver::EventReceiver()
 
 bool EventReceiver::OnEvent(const SEvent &event)
 {
+    if (event.EventType == EET_KEY_INPUT_EVENT ||
+        event.EventType == EET_MOUSE_INPUT_EVENT ||
+        event.EventType == EET_GUI_EVENT)
+        input = true;
+
     // if the event is related to keys
     if (event.EventType == EET_KEY_INPUT_EVENT) {
         pressedKeys[event.KeyInput.Key] = event.KeyInput.PressedDown;
@@ -91,6 +96,13 @@ bool EventReceiver::checkKeyPressed(EKEY_CODE keyCode)
     return result;
 }
 
+bool EventReceiver::checkInput()
+{
+    const bool result = input;
+    input = false;
+    return result;
+}
+
 void EventReceiver::startCatchingKey()
 {
     catchingKey = true;
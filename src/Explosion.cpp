@@ -99,6 +99,6 @@ void Explosion::startAnimation()
     particleSystem->setPosition(core::vector3df(position.x(), position.y(), position.z()));
     particleSystem->setScale(core::vector3df(20, 20, 20));
     particleSystem->setMaterialFlag(video::EMF_ZWRITE_ENABLE, false);
-    particleSystem->setMaterialTexture(0, device.getVideoDriver()->getTexture("media/textures/lsd.png"));
+    particleSystem->setMaterialTexture(0, AssetCache::getInstance().texture(device, "media/textures/lsd.png"));
     particleSystem->setMaterialType(video::EMT_TRANSPARENT_ADD_COLOR);*/
 }
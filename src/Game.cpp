@@ -18,21 +18,40 @@
 
 using namespace irr;
 
-Game::Game(const ConfigData &data)
+// fixed step of generation and control handling, ms
+constexpr unsigned int tick = 1000.0f / 60.0f;
+// longest sleep of the menu loop between checking for input, ms
+constexpr u32 MENU_SLEEP = 10;
+// interval of logging the CPU usage of the menu, ms
+constexpr u32 MENU_USAGE_INTERVAL = 10000;
+
+Game::Game(const ConfigData &data, video::E_DRIVER_TYPE driverType) :
+    driverType(driverType)
 {
     // load configuration, initialize device and GUI
     configuration = data;
     initializeDevice();
+
+    // show an empty window while the rest is being loaded
+    driver->beginScene(true, true, DEFAULT_COLOR);
+    driver->endScene();
+    AssetLoader::loadAll();
+
     initializeGUI();
 }
 
 Game::~Game()
 {
+    if (TraceRecorder::getInstance().recording())
+        TraceRecorder::getInstance().stop();
+
     terminateDevice();
+    AssetCache::getInstance().clear();
 }
 
 void Game::start()
 {
+    TraceRecorder::getInstance().setThreadName("main");
     mainMenu();
 }
 
@@ -44,9 +63,9 @@ void Game::initializeGUI()
     if (font)
         skin->setFont(font);
     font = nullptr;
+    prewarmFont();
 
-    Game::setSpriteBank(false);
-    Game::setSpriteBank(true);
+    setSpriteBanks();
     gui = std::make_unique<GUI>(configuration, *guiEnvironment);
     gui->addScreen(std::make_unique<MainMenuScreen>(configuration, *guiEnvironment), Screen::MAIN_MENU);
     gui->addScreen(std::make_unique<SettingsScreen>(configuration, *guiEnvironment), Screen::SETTINGS);
@@ -58,6 +77,20 @@ void Game::initializeGUI()
     //device->getGUIEnvironment()->getSkin()->setColor(gui::EGDC_BUTTON_TEXT,video::SColor(255,200,200,200));
 }
 
+void Game::prewarmFont()
+{
+    auto *font = dynamic_cast<gui::CGUITTFont *>(skin->getFont());
+    if (!font)
+        return;
+
+    u32 begin = timer->getRealTime();
+    std::wstring characters = catalogueCharacters(configuration.language);
+    font->prewarm(characters.c_str());
+    Log::getInstance().debug("prewarmed ", characters.size(), " glyphs in ",
+                             timer->getRealTime() - begin, "ms, ",
+                             font->getPageCount(), " glyph pages");
+}
+
 void Game::initializeDevice()
 {
     if (initialized)
@@ -65,7 +98,7 @@ void Game::initializeDevice()
 
     // if fullscreen is enabled, create an empty device
     //      to get screen resolution
-    if (configuration.fullscreen)
+    if (configuration.fullscreen && driverType != video::EDT_NULL)
     {
         IrrlichtDevice *nulldevice = createDevice(video::EDT_NULL);
         if (!nulldevice)
@@ -76,7 +109,7 @@ void Game::initializeDevice()
 
     // create device (which is simply a window in which the
     //      whole world is rendered)
-    device = createDevice(video::EDT_OPENGL, configuration.resolution, 32,
+    device = createDevice(driverType, configuration.resolution, 32,
                                    configuration.fullscreen, configuration.stencilBuffer,
                                    configuration.vsync);
     if (!device)
@@ -97,9 +130,25 @@ void Game::initializeDevice()
     timer->setTime(0);
     timer->start();
 
+    // a device created again gets the textures and meshes from memory
+    AssetCache::getInstance().restore(*device);
+
     initialized = true;
 }
 
+// the CPU-side assets are kept, see AssetCache
+void Game::recreateDevice()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    terminateDevice();
+    initializeDevice();
+    initializeGUI();
+
+    Log::getInstance().info("device recreated in ", std::chrono::duration<float, std::milli>(
+                                std::chrono::steady_clock::now() - start).count(), " ms");
+}
+
 void Game::terminateDevice()
 {
     Config::saveConfig("game.conf", configuration);
@@ -111,56 +160,46 @@ void Game::terminateDevice()
     initialized = false;
 }
 
-void Game::setSpriteBank(bool isControlButton)
+void Game::setSpriteBanks()
 {
-    // add textures into sprite bank
-    gui::IGUISpriteBank *spriteBank;
-    if (!isControlButton) {
-        spriteBank = guiEnvironment->addEmptySpriteBank("SpritesForRegularButtons");
-        spriteBank->addTexture(driver->getTexture("media/textures/button_up.png")); // 0
-        spriteBank->addTexture(driver->getTexture("media/textures/button_over.png")); // 1
-        spriteBank->addTexture(driver->getTexture("media/textures/button_down.png")); // 2
-        spriteBank->addTexture(driver->getTexture("media/textures/button_focused.png")); // 3
-        // add sizes
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/button_up.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/button_over.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/button_down.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/button_focused.png"))->getOriginalSize()));
-    } else {
-        spriteBank = guiEnvironment->addEmptySpriteBank("SpritesForControlButtons");
-        spriteBank->addTexture(driver->getTexture("media/textures/cbutton_up.png")); // 0
-        spriteBank->addTexture(driver->getTexture("media/textures/cbutton_over.png")); // 1
-        spriteBank->addTexture(driver->getTexture("media/textures/cbutton_down.png")); // 2
-        spriteBank->addTexture(driver->getTexture("media/textures/cbutton_focused.png")); // 3
-        // add sizes
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/cbutton_up.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/cbutton_over.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/cbutton_down.png"))->getOriginalSize()));
-        spriteBank->getPositions().push_back(core::rect<s32>(core::position2di(0,0),
-                (driver->getTexture("media/textures/cbutton_focused.png"))->getOriginalSize()));
-    }
-    // add sprites
-    gui::SGUISprite sprite;
-    gui::SGUISpriteFrame sframe;
-    sprite.Frames.push_back(sframe);
-    for (int i = 0; i <= 3; i++) {
-        sprite.Frames[0].rectNumber = i;
-        sprite.Frames[0].textureNumber = i;
-        spriteBank->getSprites().push_back(sprite);
+    // the states of both kinds of buttons are packed into one texture,
+    //      so all the buttons of a menu are drawn from it
+    const std::vector<io::path> files = {
+        "media/textures/button_up.png",
+        "media/textures/button_over.png",
+        "media/textures/button_down.png",
+        "media/textures/button_focused.png",
+        "media/textures/cbutton_up.png",
+        "media/textures/cbutton_over.png",
+        "media/textures/cbutton_down.png",
+        "media/textures/cbutton_focused.png"
+    };
+    std::vector<core::recti> rects;
+    video::ITexture *atlas = AssetCache::getInstance().atlas(*device, "buttons atlas", files, rects);
+    if (!atlas)
+        return;
+
+    const char *const banks[] = { "SpritesForRegularButtons", "SpritesForControlButtons" };
+    for (std::size_t bank = 0; bank < 2; bank++) {
+        gui::IGUISpriteBank *spriteBank = guiEnvironment->addEmptySpriteBank(banks[bank]);
+        spriteBank->addTexture(atlas);
+
+        // sprites 0-3 are up, over, down and focused, see IGUIScreen::setCustomButtonSkin
+        gui::SGUISprite sprite;
+        sprite.Frames.push_back(gui::SGUISpriteFrame());
+        sprite.Frames[0].textureNumber = 0;
+        for (u32 i = 0; i < 4; i++) {
+            spriteBank->getPositions().push_back(rects[bank * 4 + i]);
+            sprite.Frames[0].rectNumber = i;
+            spriteBank->getSprites().push_back(sprite);
+        }
     }
 }
 
 // show main menu
 void Game::mainMenu()
 {
-    sf::Sound menu = Audio::getInstance().menu();
+    sf::Music &menu = Audio::getInstance().music(Track::MENU);
     menu.setLoop(true);
     menu.setVolume(configuration.volume);
     menu.play();
@@ -176,6 +215,16 @@ void Game::mainMenu()
 
     ConfigData oldConfiguration = configuration;
 
+    // the menu is redrawn on input and otherwise only configuration.menuFPS times a second,
+    //      the loop sleeps in between instead of spinning
+    u32 lastDraw = timer->getRealTime();
+    bool redraw = true;
+
+    // CPU time of the process against the wall time spent in the menu
+    std::clock_t usageCPU = std::clock();
+    u32 usageStart = lastDraw;
+    u32 usageFrames = 0;
+
     while (device->run()) {
         // handle gui events
         handleSelecting();
@@ -183,12 +232,17 @@ void Game::mainMenu()
         switch (gui->getCurrentScreenIndex()) {
         case Screen::MAIN_MENU:
             if (eventReceiver->checkEvent(ID_BUTTON_START)) {
-                auto chunkDB = generateChunkDB();
+                const std::uint32_t seed = std::random_device()();
+                auto chunkDB = generateChunkDB(seed);
                 menu.pause();
-                if (run(std::move(chunkDB)))
+                if (run(std::move(chunkDB), seed))
                 {
                     menu.play();
                     gui->initialize(Screen::MAIN_MENU);
+                    redraw = true;
+                    usageCPU = std::clock();
+                    usageStart = timer->getRealTime();
+                    usageFrames = 0;
                     continue;
                 }
                 else
@@ -243,6 +297,7 @@ void Game::mainMenu()
                     configuration.language = "";
                 }
                 setLanguage(configuration.language, true);
+                prewarmFont();
                 gui->reload();
             }
             if (eventReceiver->checkEvent(ID_COMBOBOX_RESOLUTION)) {
@@ -260,9 +315,7 @@ void Game::mainMenu()
                         break;
                 }
 
-                terminateDevice();
-                initializeDevice();
-                initializeGUI();
+                recreateDevice();
                 oldConfiguration = configuration;
 
                 gui->initialize(Screen::SETTINGS);
@@ -274,9 +327,7 @@ void Game::mainMenu()
             if (eventReceiver->checkEvent(ID_BUTTON_TOGGLE_FULLSCREEN)) {
                 configuration.fullscreen = !configuration.fullscreen;
 
-                terminateDevice();
-                initializeDevice();
-                initializeGUI();
+                recreateDevice();
                 oldConfiguration = configuration;
 
                 gui->initialize(Screen::SETTINGS);
@@ -297,9 +348,7 @@ void Game::mainMenu()
             {
                 bool needRestart = configuration.needRestart(oldConfiguration);
                 if (needRestart) {
-                    terminateDevice();
-                    initializeDevice();
-                    initializeGUI();
+                    recreateDevice();
                 }
 
                 gui->initialize(Screen::MAIN_MENU);
@@ -310,11 +359,9 @@ void Game::mainMenu()
             }
 
             {
-                core::stringw scrs = _w("Screen size: ");
-                scrs += configuration.resolution.Width;
-                scrs += "x";
-                scrs += configuration.resolution.Height;
-                gui->getCurrentScreenAsSettings().textScreenSize->setText(scrs.c_str());
+                auto &screen = gui->getCurrentScreenAsSettings();
+                screen.screenSize.set(L"%ls%ux%u", screen.labelScreenSize.get(),
+                                      configuration.resolution.Width, configuration.resolution.Height);
             }
 
             break;
@@ -366,11 +413,9 @@ void Game::mainMenu()
             }
 
             {
-                core::stringw scrs = _w("Screen size: ");
-                scrs += configuration.resolution.Width;
-                scrs += "x";
-                scrs += configuration.resolution.Height;
-                gui->getCurrentScreenAsControlSettings().textScreenSize->setText(scrs.c_str());
+                auto &screen = gui->getCurrentScreenAsControlSettings();
+                screen.screenSize.set(L"%ls%ux%u", screen.labelScreenSize.get(),
+                                      configuration.resolution.Width, configuration.resolution.Height);
             }
             break;
         default:
@@ -381,27 +426,56 @@ void Game::mainMenu()
         if (configuration.resolution != driver->getScreenSize()) {
             oldConfiguration.resolution = configuration.resolution = driver->getScreenSize();
             gui->resize();
+            redraw = true;
         }
 
-        if (device->isWindowActive()) {
+        if (eventReceiver->checkInput())
+            redraw = true;
+
+        const u32 now = timer->getRealTime();
+        const u32 interval = configuration.menuFPS > 0 ? 1000 / configuration.menuFPS : 0;
+        if (now - lastDraw >= interval)
+            redraw = true;
+
+        if (!device->isWindowActive()) {
+            device->sleep(MENU_SLEEP);
+        } else if (redraw) {
             //if (IRIDESCENT_BACKGROUND)
                 driver->beginScene(true, true, iridescentColor(timer->getTime()));
             //else
             //    driver->beginScene(true, true, DEFAULT_COLOR);
             guiEnvironment->drawAll();
             driver->endScene();
+
+            lastDraw = now;
+            redraw = false;
+            usageFrames++;
         } else {
-            device->yield();
+            device->sleep(std::min(interval - (now - lastDraw), MENU_SLEEP));
+        }
+
+        if (now - usageStart >= MENU_USAGE_INTERVAL) {
+            const double cpu = 1000.0 * (std::clock() - usageCPU) / CLOCKS_PER_SEC;
+            Log::getInstance().debug("menu: ", usageFrames, " frames in ", now - usageStart, " ms, CPU time ",
+                                     cpu, " ms (", 100.0 * cpu / (now - usageStart), "%)");
+            usageCPU = std::clock();
+            usageStart = now;
+            usageFrames = 0;
         }
     }
 }
 
 // start the game itself
 // returns false if quit is pressed
-bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
+bool Game::run(std::unique_ptr<ChunkDB> chunkDB, std::uint32_t seed)
 {
+    InputRecorder recorder;
+    if (!recordingFile.empty() && recorder.open(recordingFile, seed, configuration.renderDistance))
+        Log::getInstance().notice("recording the run into \"", recordingFile, "\"");
+    std::vector<ControlState> tickControls;
+
     // start background music
-    sf::Sound background = Audio::getInstance().background();
+    sf::Music &background = Audio::getInstance().music(Track::BACKGROUND);
     background.setLoop(true);
     background.setVolume(configuration.volume);
     background.play();
@@ -410,14 +484,30 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
     world = std::make_unique<World>(*device, configuration, *chunkDB);
     planeControl = std::make_unique<PlaneControl>(world->plane(), configuration.controls);
 
-    constexpr unsigned int tick = 1000.0f / 60.0f;
+    RunRecord runRecord;
+    runRecord.seed = seed;
+    runRecord.renderDistance = configuration.renderDistance;
+    std::vector<float> frameTimes;
+    btVector3 lastPosition = world->plane().getPosition();
+
     u32 timePrevious, timeCurrent;
     u64 accumulator, deltaTime = 0;
 
     timePrevious = timeCurrent = accumulator = timer->getTime();
 
+    bool simulatedFrame = false; // only frames of the flight itself go to frameStats and the profiler
+
     while (device->run())
     {
+        if (simulatedFrame) {
+            Profiler::getInstance().endFrame();
+            frameStats.addFrame(world->obstacles());
+            frameTimes.push_back(Profiler::getInstance().last(Stage::FRAME));
+        } else {
+            Profiler::getInstance().discardFrame();
+        }
+        simulatedFrame = false;
+
         video::SColor color = iridescentColor(timer->getTime());
 
         if (device->isWindowActive()) {
@@ -438,11 +528,9 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
             case Screen::PAUSE_MENU:
                 // screen size
                 {
-                    core::stringw scrs = _w("Screen size: ");
-                    scrs += configuration.resolution.Width;
-                    scrs += "x";
-                    scrs += configuration.resolution.Height;
-                    gui->getCurrentScreenAsPauseMenu().textScreenSize->setText(scrs.c_str());
+                    auto &screen = gui->getCurrentScreenAsPauseMenu();
+                    screen.screenSize.set(L"%ls%ux%u", screen.labelScreenSize.get(),
+                                          configuration.resolution.Width, configuration.resolution.Height);
                 }
 
                 // set cursor visible
@@ -460,11 +548,13 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
                 if (eventReceiver->checkKeyPressed(KEY_LEFT) ||
                     eventReceiver->checkEvent(ID_BUTTON_MENU))
                 {
+                    background.stop();
                     world.reset();
                     return true;
                 }
 
                 if (eventReceiver->checkEvent(ID_BUTTON_QUIT)) {
+                    background.stop();
                     world.reset();
                     return false;
                 }
@@ -476,9 +566,8 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
 
             case Screen::GAME_OVER: {
                 {
-                    core::stringw score(_w("Your score: "));
-                    score += world->plane().score();
-                    gui->getCurrentScreenAsGameOver().textScore->setText(score.c_str());
+                    auto &screen = gui->getCurrentScreenAsGameOver();
+                    screen.score.set(L"%ls%ld", screen.labelScore.get(), world->plane().score());
                 }
 
                 // set cursor visible
@@ -497,6 +586,7 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
                 handleSelecting();
 
                 if (eventReceiver->checkEvent(ID_BUTTON_MENU)) {
+                    background.stop();
                     world.reset();
                     return true;
                 }
@@ -511,8 +601,15 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
                 const float step = timeCurrent - timePrevious;
                 world->stepSimulation((step / 1000.0), 10, tick / 1000.0f);
                 timePrevious = timeCurrent;
+                simulatedFrame = true;
+
+                runRecord.duration += step;
+                const btVector3 position = world->plane().getPosition();
+                runRecord.distance += (position - lastPosition).length();
+                lastPosition = position;
 
                 if (eventReceiver->checkKeyPressed(KEY_ESCAPE)) {
+                    recorder.frame(step, {});
                     gui->initialize(Screen::PAUSE_MENU);
                     continue;
                 }
@@ -520,28 +617,43 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
                     gui->getCurrentScreenAsHUD().setInfoVisible(!gui->getCurrentScreenAsHUD().getInfoVisible());
                     gui->reload();
                 }
+                // start or stop recording a trace
+                if (eventReceiver->checkKeyPressed(KEY_F4)) {
+                    if (TraceRecorder::getInstance().recording())
+                        TraceRecorder::getInstance().stop();
+                    else
+                        TraceRecorder::getInstance().start();
+                }
 
                 if (world->gameOver()) {
+                    recorder.frame(step, {});
                     background.stop();
 
                     gui->initialize(Screen::GAME_OVER);
-                    std::vector<s32> score = Scoreboard::loadScore("score.txt");
-                    score.push_back((world->plane().score()));
-                    std::sort(score.begin(), score.end(), std::greater<int>());
-                    Scoreboard::saveScore("score.txt", score);
+                    saveRun(runRecord, frameTimes);
                     continue;
                 }
 
                 deltaTime = timer->getTime() - accumulator;
-                Log::getInstance().debug("generation and control handling delta = ", deltaTime, "ms");
+                if (Log::enabled(severity_level::debug))
+                    Log::getInstance().debug("generation and control handling delta = ", deltaTime, "ms");
+                tickControls.clear();
                 while (deltaTime >= tick) {
                     deltaTime -= tick;
                     accumulator += tick;
 
-                    world->generate();
-                    planeControl->handle(*eventReceiver); // handle plane controls
+                    {
+                        ScopedTimer timer(Stage::GENERATION);
+                        world->generate();
+                    }
+                    {
+                        ScopedTimer timer(Stage::INPUT);
+                        tickControls.push_back(planeControl->read(*eventReceiver));
+                        planeControl->handle(tickControls.back()); // handle plane controls
+                    }
                     world->plane().addScore(2);
                 }
+                recorder.frame(step, tickControls);
 
                 Log::getInstance().debug("=== END SIMULATION STEP ===");
 
@@ -555,7 +667,10 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
                 break;
             }
 
-            guiEnvironment->drawAll();
+            {
+                ScopedTimer timer(Stage::GUI_DRAW);
+                drawGUI();
+            }
             driver->endScene();
         } else {
             if (gui->getCurrentScreenIndex() == Screen::PAUSE_MENU) {
@@ -567,82 +682,279 @@ bool Game::run(std::unique_ptr<ChunkDB> chunkDB)
         }
     }
 
-//    Audio::getInstance().background.stop();
+    background.stop();
     world.reset();
     return false;
 }
 
+void Game::setRecordingFile(const std::string &filename)
+{
+    recordingFile = filename;
+}
+
+// repeats the simulation steps and control ticks of a recorded run
+//      in the same order as run does
+bool Game::replay(const std::string &filename)
+{
+    InputReplay input;
+    if (!input.open(filename))
+        return false;
+
+    // the recorded render distance is only used for the replay
+    const ConfigData savedConfiguration = configuration;
+    configuration.renderDistance = input.renderDistance();
+    auto chunkDB = generateChunkDB(input.seed());
+
+    gui->initialize(Screen::HUD);
+    world = std::make_unique<World>(*device, configuration, *chunkDB);
+    planeControl = std::make_unique<PlaneControl>(world->plane(), configuration.controls);
+
+    std::uint32_t step;
+    std::vector<ControlState> tickControls;
+    std::size_t frames = 0;
+
+    while (device->run() && input.nextFrame(step, tickControls)) {
+        if (frames > 0) {
+            Profiler::getInstance().endFrame();
+            frameStats.addFrame(world->obstacles());
+        } else {
+            Profiler::getInstance().discardFrame();
+        }
+
+        world->stepSimulation(step / 1000.0, 10, tick / 1000.0f);
+        if (world->gameOver())
+            break;
+
+        for (ControlState controls : tickControls) {
+            {
+                ScopedTimer timer(Stage::GENERATION);
+                world->generate();
+            }
+            {
+                ScopedTimer timer(Stage::INPUT);
+                planeControl->handle(controls);
+            }
+            world->plane().addScore(2);
+        }
+
+        if (driverType != video::EDT_NULL) {
+            driver->beginScene(true, true, DEFAULT_COLOR);
+            world->render(iridescentColor(timer->getTime()));
+            updateHUD();
+            {
+                ScopedTimer timer(Stage::GUI_DRAW);
+                drawGUI();
+            }
+            driver->endScene();
+        }
+
+        frames++;
+    }
+
+    const btVector3 position = world->plane().getPosition();
+    Log::getInstance().notice("median frame ", frameStats.median(), " ms, 99th percentile ",
+                              frameStats.percentile(0.99f), " ms, ", frameStats.hitches(), " hitches");
+    Log::getInstance().notice("replay of \"", filename, "\" finished after ", frames, " frames: score ",
+                              world->plane().score(), ", position (", position.x(), ", ",
+                              position.y(), ", ", position.z(), ")");
+
+    world.reset();
+    configuration = savedConfiguration;
+    return true;
+}
+
+void Game::saveRun(RunRecord &record, std::vector<float> &frameTimes)
+{
+    record.score = world->plane().score();
+    record.obstaclesPassed = world->obstaclesPassed();
+    record.collisions = world->collisions();
+    std::strncpy(record.build, PLAINE_BUILD_ID, sizeof(record.build) - 1);
+
+    if (!frameTimes.empty()) {
+        record.averageFrame = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f) / frameTimes.size();
+
+        auto p99 = frameTimes.begin() + (frameTimes.size() - 1) * 99 / 100;
+        std::nth_element(frameTimes.begin(), p99, frameTimes.end());
+        record.p99Frame = *p99;
+    }
+
+    const std::size_t place = ScoreStore::getInstance().add(record);
+    Log::getInstance().info("run finished: score ", record.score, ", place ", place, ", ",
+                            record.duration / 1000, " s, ", record.collisions, " collisions, frame ",
+                            record.averageFrame, " ms on average, ", record.p99Frame, " ms 99th percentile");
+}
+
+bool Game::perf(const std::string &outputFile, const std::string &replayFile)
+{
+    return PerfRunner(*device, configuration).run(outputFile, replayFile);
+}
+
+bool Game::perfText(const std::string &outputFile)
+{
+    return PerfRunner(*device, configuration).runText(outputFile);
+}
+
+void Game::drawGUI()
+{
+    // the HUD texts don't overlap, so they can be drawn after all their backgrounds
+    auto *font = dynamic_cast<gui::CGUITTFont *>(skin->getFont());
+    const bool batch = font && gui->getCurrentScreenIndex() == Screen::HUD;
+
+    if (batch)
+        font->beginBatch();
+    guiEnvironment->drawAll();
+    if (batch)
+        font->endBatch();
+}
+
 void Game::updateHUD()
 {
+    HUDScreen &hud = gui->getCurrentScreenAsHUD();
+
     // camera position
-    {
-        core::stringw cameraPosition = _w("Plane position: (");
+    if (hud.cameraPosition.active()) {
         core::vector3df position = world->plane().node().getPosition();
-        cameraPosition += position.X;
-        cameraPosition += ", ";
-        cameraPosition += position.Y;
-        cameraPosition += ", ";
-        cameraPosition += position.Z;
-        cameraPosition += ")";
-        gui->getCurrentScreenAsHUD().textCameraPosition->setText(cameraPosition.c_str());
-
-        Log::getInstance().debug("plane position = (", position.X, ", ", position.Y, ", ", position.Z, ")");
+        hud.cameraPosition.set(L"%ls%.2f, %.2f, %.2f)", hud.labelPosition.get(), position.X, position.Y, position.Z);
+
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug("plane position = (", position.X, ", ", position.Y, ", ", position.Z, ")");
     }
 
     // cube counter
-    {
-        core::stringw obstacles = _w("Obstacles: ");
-        obstacles += world->obstacles();
-        gui->getCurrentScreenAsHUD().textObstaclesCount->setText(obstacles.c_str());
+    if (hud.obstaclesCount.active()) {
+        hud.obstaclesCount.set(L"%ls%lu", hud.labelObstacles.get(), static_cast<unsigned long>(world->obstacles()));
 
-        Log::getInstance().debug("obstacles = ", world->obstacles());
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug("obstacles = ", world->obstacles());
     }
 
     // fps counter
-    {
-        core::stringw fps = _w("FPS: ");
-        fps += driver->getFPS();
-        gui->getCurrentScreenAsHUD().textFPS->setText(fps.c_str());
+    if (hud.fps.active()) {
+        hud.fps.set(L"%ls%d", hud.labelFPS.get(), driver->getFPS());
 
-        Log::getInstance().debug("FPS = ", driver->getFPS());
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug("FPS = ", driver->getFPS());
     }
 
     // velocity counter
-    {
-        core::stringw velocity = _w("Linear velocity: ");
-        velocity += (int) world->plane().rigidBody().getLinearVelocity().length();
-        velocity += _w("; Angular velocity: ");
-        velocity += world->plane().rigidBody().getAngularVelocity().length();
-        gui->getCurrentScreenAsHUD().textVelocity->setText(velocity.c_str());
-
-        Log::getInstance().debug("linear velocity = ", world->plane().getLinearVelocity().length());
-        Log::getInstance().debug("angular velocity = ", world->plane().getLinearVelocity().length());
+    if (hud.velocity.active()) {
+        hud.velocity.set(L"%ls%d%ls%.2f", hud.labelLinearVelocity.get(),
+                         (int) world->plane().rigidBody().getLinearVelocity().length(),
+                         hud.labelAngularVelocity.get(),
+                         world->plane().rigidBody().getAngularVelocity().length());
+
+        if (Log::enabled(severity_level::debug)) {
+            Log::getInstance().debug("linear velocity = ", world->plane().getLinearVelocity().length());
+            Log::getInstance().debug("angular velocity = ", world->plane().getLinearVelocity().length());
+        }
     }
 
     // rotation counter
-    {
+    if (hud.angle.active()) {
         btVector3 rotation = world->plane().getEulerRotationDeg();
+        hud.angle.set(L"%ls%.1f%ls%.1f%ls%.1f%ls", hud.labelPitch.get(), rotation.x(), hud.labelYaw.get(),
+                      rotation.y(), hud.labelRoll.get(), rotation.z(), hud.labelDegree.get());
 
-        core::stringw rotation_str = _w("Pitch: ");
-        rotation_str += rotation.x();
-        rotation_str += _w("°; Yaw: ");
-        rotation_str += rotation.y();
-        rotation_str += _w("°; Roll: ");
-        rotation_str += rotation.z();
-        rotation_str += _w("°");
-        gui->getCurrentScreenAsHUD().textAngle->setText(rotation_str.c_str());
-
-        Log::getInstance().debug("rotation = (", rotation.x(), ", ", rotation.y(), ", ", rotation.z(), ")");
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug("rotation = (", rotation.x(), ", ", rotation.y(), ", ", rotation.z(), ")");
     }
 
     // score counter
-    {
-        core::stringw score = _w("Score: ");
-        score += world->plane().score();
-        gui->getCurrentScreenAsHUD().textScore->setText(score.c_str());
+    if (hud.score.active()) {
+        hud.score.set(L"%ls%ld", hud.labelScore.get(), world->plane().score());
+
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug("score = ", world->plane().score());
+    }
+
+#if PROFILER_ENABLED
+    // stage timings over the last frames
+    if (hud.profiler.active()) {
+        // the stage names are ASCII, they're widened once as %s in a wide format
+        //      means a wide string with msvcrt
+        static const std::array<std::wstring, STAGE_COUNT> stageNames = [] {
+            std::array<std::wstring, STAGE_COUNT> names;
+            for (std::size_t i = 0; i < STAGE_COUNT; i++) {
+                const char *name = Profiler::stageName(static_cast<Stage>(i));
+                names[i].assign(name, name + std::strlen(name));
+            }
+            return names;
+        }();
+
+        hud.profiler.clear();
+        hud.profiler.append(L"%-12ls %6ls %6ls %6ls\n", L"ms", L"min", L"avg", L"p99");
+
+        for (std::size_t i = 0; i < STAGE_COUNT; i++) {
+            const Profiler::Summary summary = Profiler::getInstance().summary(static_cast<Stage>(i));
 
-        Log::getInstance().debug("score = ", world->plane().score());
+            hud.profiler.append(L"%-12ls %6.2f %6.2f %6.2f\n", stageNames[i].c_str(),
+                                summary.min, summary.avg, summary.p99);
+        }
+        hud.profiler.commit();
     }
+#endif // PROFILER_ENABLED
+
+#if MEMORY_STATS_ENABLED
+    updateMemoryStats();
+#endif // MEMORY_STATS_ENABLED
+}
+
+static std::size_t countSceneNodes(const scene::ISceneNode &node)
+{
+    std::size_t count = 1;
+    for (const scene::ISceneNode *child : node.getChildren())
+        count += countSceneNodes(*child);
+
+    return count;
+}
+
+// shows memory usage once a second and logs it every 10 seconds
+void Game::updateMemoryStats()
+{
+    const u32 now = timer->getTime();
+    const u32 elapsed = now - lastMemoryUpdate;
+    if (elapsed < 1000)
+        return;
+
+    const MemoryStats::Snapshot snapshot = MemoryStats::snapshot();
+    const std::size_t sceneNodes = countSceneNodes(*sceneManager->getRootSceneNode()) - 1;
+    const std::size_t audioBytes = Audio::getInstance().bufferBytes();
+    auto *font = dynamic_cast<gui::CGUITTFont *>(skin->getFont());
+    const std::size_t fontBytes = font ? font->getPageTextureBytes() : 0;
+    const bool log = memoryUpdates++ % 10 == 0;
+
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-12s %8s %9s\n", "memory", "KiB", "allocs/s");
+    core::stringw memory = line;
+
+    for (std::size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        const char *name = MemoryStats::categoryName(static_cast<MemoryCategory>(i));
+        const std::size_t kib = snapshot.bytes[i] / 1024;
+        const std::size_t rate = (snapshot.allocations[i] - lastMemorySnapshot.allocations[i]) * 1000 / elapsed;
+
+        std::snprintf(line, sizeof(line), "%-12s %8lu %9lu\n", name,
+                      static_cast<unsigned long>(kib), static_cast<unsigned long>(rate));
+        memory += line;
+
+        if (log)
+            Log::getInstance().info("memory: ", name, " ", kib, " KiB, ", rate, " allocations/s");
+    }
+
+    std::snprintf(line, sizeof(line), "%-12s %8lu\n%-12s %8lu\n%-12s %8lu\n",
+                  "audio", static_cast<unsigned long>(audioBytes / 1024),
+                  "font pages", static_cast<unsigned long>(fontBytes / 1024),
+                  "scene nodes", static_cast<unsigned long>(sceneNodes));
+    memory += line;
+
+    if (log)
+        Log::getInstance().info("memory: audio ", audioBytes / 1024, " KiB, font pages ", fontBytes / 1024,
+                                " KiB, ", sceneNodes, " scene nodes");
+
+    if (gui->getCurrentScreenAsHUD().getInfoVisible())
+        gui->getCurrentScreenAsHUD().textMemory->setText(memory.c_str());
+
+    lastMemorySnapshot = snapshot;
+    lastMemoryUpdate = now;
 }
 
 void Game::handleSelecting()
@@ -676,7 +988,9 @@ void Game::handleSelecting()
 }
 
 
-std::unique_ptr<ChunkDB> Game::generateChunkDB()
+// every chunk is generated from its own seed, so the result
+//      doesn't depend on how chunks are split between threads
+std::unique_ptr<ChunkDB> Game::generateChunkDB(std::uint32_t seed, float density)
 {
     auto chunkDB = std::make_unique<ChunkDB>();
 
@@ -685,17 +999,24 @@ std::unique_ptr<ChunkDB> Game::generateChunkDB()
     static const std::size_t CHUNKS_PER_THREAD = CHUNK_DB_SIZE / THREADS;
 
     auto generateRange =
-        [&chunkDB](std::size_t begin, std::size_t end) mutable
+        [&chunkDB, seed, density](std::size_t begin, std::size_t end) mutable
         {
-            for (std::size_t i = begin; i < end; i++)
-                chunkDB->at(i).generate();
+            TraceScope trace("generate chunks", end - begin);
+            for (std::size_t i = begin; i < end; i++) {
+                TraceScope chunkTrace("generate chunk");
+                Randomizer::seed(seed + i);
+                chunkDB->at(i).generate(density);
+            }
         };
 
     std::vector<std::thread> threads;
 
     // first THREADS - 1 pieces
     for (std::size_t i = 0; i < THREADS - 1; i++)
-        threads.emplace_back(generateRange, i * CHUNKS_PER_THREAD, (i + 1) * CHUNKS_PER_THREAD);
+        threads.emplace_back([generateRange, i]() mutable {
+            TraceRecorder::getInstance().setThreadName("chunk generator");
+            generateRange(i * CHUNKS_PER_THREAD, (i + 1) * CHUNKS_PER_THREAD);
+        });
 
     // last piece
     generateRange((THREADS - 1) * CHUNKS_PER_THREAD, chunkDB->size());
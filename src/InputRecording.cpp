@@ -0,0 +1,110 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstring>
+#include "InputRecording.h"
+
+constexpr char InputRecorder::MAGIC[4];
+constexpr std::uint32_t InputRecorder::VERSION;
+
+bool InputRecorder::open(const std::string &filename, std::uint32_t seed, std::uint32_t renderDistance)
+{
+    m_file.open(filename, std::ios::binary);
+    if (!m_file.is_open()) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for writing.");
+        return false;
+    }
+
+    InputRecordingHeader header {};
+    std::copy(MAGIC, MAGIC + 4, header.magic);
+    header.version = VERSION;
+    header.seed = seed;
+    header.renderDistance = renderDistance;
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    return true;
+}
+
+void InputRecorder::frame(std::uint32_t step, const std::vector<ControlState> &ticks)
+{
+    if (!m_file.is_open())
+        return;
+
+    // a frame can't hold more than 255 ticks, the rest goes to empty frames
+    std::size_t written = 0;
+    do {
+        const std::uint8_t count = std::min<std::size_t>(ticks.size() - written, 255);
+
+        m_file.write(reinterpret_cast<const char *>(&step), sizeof(step));
+        m_file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        m_file.write(reinterpret_cast<const char *>(ticks.data() + written), count);
+
+        written += count;
+        step = 0;
+    } while (written < ticks.size());
+}
+
+bool InputReplay::open(const std::string &filename)
+{
+    if (!m_file.open(filename)) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for reading.");
+        return false;
+    }
+
+    if (m_file.size() < sizeof(InputRecordingHeader)) {
+        Log::getInstance().warning("recording \"", filename, "\" is truncated.");
+        m_file.close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+    if (!std::equal(m_header.magic, m_header.magic + 4, InputRecorder::MAGIC) ||
+        m_header.version != InputRecorder::VERSION)
+    {
+        Log::getInstance().warning("recording \"", filename, "\" is of an incompatible format.");
+        m_file.close();
+        return false;
+    }
+
+    m_position = sizeof(m_header);
+
+    return true;
+}
+
+bool InputReplay::nextFrame(std::uint32_t &step, std::vector<ControlState> &ticks)
+{
+    constexpr std::size_t FRAME_HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+
+    if (!m_file.isOpen() || m_file.size() - m_position < FRAME_HEADER_SIZE)
+        return false;
+
+    const char *data = m_file.data() + m_position;
+    std::memcpy(&step, data, sizeof(step));
+    const std::uint8_t count = data[sizeof(step)];
+
+    if (m_file.size() - m_position - FRAME_HEADER_SIZE < count) {
+        Log::getInstance().warning("recording is truncated.");
+        return false;
+    }
+
+    data += FRAME_HEADER_SIZE;
+    ticks.assign(data, data + count);
+    m_position += FRAME_HEADER_SIZE + count;
+
+    return true;
+}
@@ -14,6 +14,105 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include "Log.h"
 
-Log Log::instance;
+constexpr std::size_t Log::RECORD_SIZE;
+
+Log::Log()
+{
+    for (std::size_t i = 0; i < RING_SIZE; i++)
+        m_ring[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_writer = std::thread(&Log::writerLoop, this);
+}
+
+Log::~Log()
+{
+    m_running.store(false, std::memory_order_release);
+    m_writer.join();
+}
+
+std::size_t Log::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+// bounded multi-producer queue: a slot is free for position pos
+//      when its sequence equals pos and filled when it equals pos + 1
+void Log::push(severity_level level, const char *text, std::size_t length)
+{
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Record *record;
+
+    while (true) {
+        record = &m_ring[pos & (RING_SIZE - 1)];
+        const std::size_t sequence = record->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) { // the ring is full
+            if (level > severity_level::warning) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::this_thread::yield();
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->length = std::min(length, RECORD_SIZE);
+    std::memcpy(record->text, text, record->length);
+    record->sequence.store(pos + 1, std::memory_order_release);
+}
+
+// writes the next record if there's one
+bool Log::pop()
+{
+    Record &record = m_ring[m_dequeuePos & (RING_SIZE - 1)];
+    if (record.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        return false;
+
+    out.write(record.text, record.length);
+    out.put('\n');
+
+    record.sequence.store(m_dequeuePos + RING_SIZE, std::memory_order_release);
+    m_dequeuePos++;
+
+    return true;
+}
+
+void Log::writerLoop()
+{
+    while (true) {
+        // records pushed before the destructor was called must be written
+        const bool running = m_running.load(std::memory_order_acquire);
+
+        std::size_t written = 0;
+        while (pop())
+            written++;
+
+        const std::size_t dropped = this->dropped();
+        if (dropped != m_reportedDropped) {
+            out << severity_level::warning << " " << dropped - m_reportedDropped
+                << " log records dropped\n";
+            m_reportedDropped = dropped;
+            written++;
+        }
+
+        if (written > 0)
+            out.flush();
+        else if (!running)
+            break;
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
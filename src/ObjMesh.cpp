@@ -312,3 +312,21 @@ void ObjMesh::setPoints(btConvexHullShape &shape)
     for (const btVector3 &vertex : vertices)
         shape.addPoint(vertex);
 }
+
+const std::vector<btVector3> &ObjMesh::getVertices() const
+{
+    return vertices;
+}
+
+std::vector<std::uint32_t> ObjMesh::getTriangleIndices() const
+{
+    std::vector<std::uint32_t> indices;
+    for (const std::vector<std::size_t> &polygon : polygons)
+        for (std::size_t i = 1; i < polygon.size() - 1; i++) {
+            indices.push_back(polygon[0]);
+            indices.push_back(polygon[i]);
+            indices.push_back(polygon[i + 1]);
+        }
+
+    return indices;
+}
@@ -23,40 +23,73 @@ ObstacleGenerator::ObstacleGenerator(btDynamicsWorld &world, IrrlichtDevice &dev
 
 void ObstacleGenerator::generate(const btVector3 &playerPosition, const ChunkDB &chunkDB)
 {
-    unsigned long obstaclesGenerated = 0;
+    {
+        TraceScope trace("produce obstacles");
+        unsigned long obstaclesGenerated = 0;
+
+        const Cuboid<long> view = fieldOfView(playerPosition) / CELL_LENGTH; //field of view in cells
+        Vector3<int> cell; // current cell to generate
 
-    const Cuboid<long> view = fieldOfView(playerPosition) / CELL_LENGTH; //field of view in cells
-    Vector3<int> cell; // current cell to generate
+        for (cell.z = back(view); cell.z <= front(generatedCuboid); cell.z++) {
+            for (cell.x = left(view); cell.x < left(generatedCuboid); cell.x++)
+                for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
+                    obstaclesGenerated += insertCell(cell, chunkDB);
 
-    for (cell.z = back(view); cell.z <= front(generatedCuboid); cell.z++) {
-        for (cell.x = left(view); cell.x < left(generatedCuboid); cell.x++)
-            for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
-                obstaclesGenerated += insertCell(cell, chunkDB);
+            for (cell.x = left(generatedCuboid); cell.x <= right(generatedCuboid); cell.x++) {
+                for (cell.y = bottom(view); cell.y < bottom(generatedCuboid); cell.y++)
+                    obstaclesGenerated += insertCell(cell, chunkDB);
 
-        for (cell.x = left(generatedCuboid); cell.x <= right(generatedCuboid); cell.x++) {
-            for (cell.y = bottom(view); cell.y < bottom(generatedCuboid); cell.y++)
-                obstaclesGenerated += insertCell(cell, chunkDB);
+                for (cell.y = top(generatedCuboid) + 1; cell.y <= top(view); cell.y++)
+                    obstaclesGenerated += insertCell(cell, chunkDB);
+            }
 
-            for (cell.y = top(generatedCuboid) + 1; cell.y <= top(view); cell.y++)
-                obstaclesGenerated += insertCell(cell, chunkDB);
+            for (cell.x = right(generatedCuboid) + 1; cell.x <= right(view); cell.x++)
+                for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
+                    obstaclesGenerated += insertCell(cell, chunkDB);
         }
 
-        for (cell.x = right(generatedCuboid) + 1; cell.x <= right(view); cell.x++)
-            for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
-                obstaclesGenerated += insertCell(cell, chunkDB);
+        for (cell.z = front(generatedCuboid) + 1; cell.z <= front(view); cell.z++)
+            for (cell.x = left(view); cell.x <= right(view); cell.x++)
+                for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
+                    obstaclesGenerated += insertCell(cell, chunkDB);
+
+        if (Log::enabled(severity_level::debug))
+            Log::getInstance().debug(obstaclesGenerated, " obstacles generated");
+
+        obstacleCount += obstaclesGenerated;
+        generatedCuboid = view;
+        trace.setCount(obstaclesGenerated);
     }
 
-    for (cell.z = front(generatedCuboid) + 1; cell.z <= front(view); cell.z++)
-        for (cell.x = left(view); cell.x <= right(view); cell.x++)
-            for (cell.y = bottom(view); cell.y <= top(view); cell.y++)
-                obstaclesGenerated += insertCell(cell, chunkDB);
+    removeLeftBehind(playerPosition.z());
+}
+
+void ObstacleGenerator::breakApart(const std::vector<const btCollisionObject *> &compounds)
+{
+    if (compounds.empty())
+        return;
 
-    Log::getInstance().debug(obstaclesGenerated, " obstacles generated");
+    TraceScope trace("break apart", compounds.size());
 
-    obstacleCount += obstaclesGenerated;
-    generatedCuboid = view;
+    // parts are pushed to the back of the list, they aren't among compounds
+    for (auto it = m_obstacles.begin(); it != m_obstacles.end();) {
+        const btRigidBody &rigidBody = (*it)->rigidBody();
 
-    removeLeftBehind(playerPosition.z());
+        if (std::find(compounds.begin(), compounds.end(), &rigidBody) == compounds.end()) {
+            it++;
+            continue;
+        }
+
+        const auto &producer = *static_cast<const CompoundProducer *>(rigidBody.getUserPointer());
+        obstacleCount += producer.breakApart(**it, world, device, m_obstacles);
+
+        it->reset();
+        it = m_obstacles.erase(it);
+        obstacleCount--;
+    }
+
+    if (Log::enabled(severity_level::debug))
+        Log::getInstance().debug(compounds.size(), " compound obstacles broken apart");
 }
 
 Cuboid<btScalar> ObstacleGenerator::fieldOfView(const btVector3 &playerPosition) const
@@ -117,20 +150,28 @@ std::size_t ObstacleGenerator::insertCell(Vector3<int> cell, const ChunkDB &chun
 // removes obstacles behind the player
 void ObstacleGenerator::removeLeftBehind(btScalar playerZ)
 {
+    TraceScope trace("remove obstacles");
+    std::size_t removed = 0;
+
     std::size_t count = 0;
     for (auto it = m_obstacles.begin();
         it != m_obstacles.end() && count < 100; count++)
     {
-        if ((*it)->getPosition().z() < playerZ - m_buffer ||
-            (*it)->getPosition().z() > playerZ + farValueWithBuffer() * 2)
+        const bool behind = (*it)->getPosition().z() < playerZ - m_buffer;
+        if (behind || (*it)->getPosition().z() > playerZ + farValueWithBuffer() * 2)
         {
+            if (behind)
+                m_passed++;
             it->reset();
             it = m_obstacles.erase(it);
             obstacleCount--;
+            removed++;
         } else {
             it++;
         }
     }
+
+    trace.setCount(removed);
 }
 
 std::size_t ObstacleGenerator::obstacles() const
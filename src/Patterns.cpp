@@ -19,31 +19,46 @@
 constexpr std::size_t Patterns::ALL;
 constexpr std::size_t Patterns::CRYSTALS;
 
-const std::array<std::shared_ptr<IObstaclePattern>, Patterns::CRYSTALS> Patterns::crystals = {
-    {
-        std::make_shared<Crystal<1, 2>>(0),
-        std::make_shared<Crystal<1, 4>>(1),
-        std::make_shared<Crystal<2, 4>>(2),
-        std::make_shared<Crystal<3, 8>>(3)
-    }
-};
-
-const std::array<std::shared_ptr<IObstaclePattern>, Patterns::CUBES> Patterns::cubes = {
-    {
-        std::make_shared<Cube<1>>(4),
-        std::make_shared<Cube<2>>(5)
-    }
-};
-
-const std::array<std::shared_ptr<IObstaclePattern>, Patterns::ALL> Patterns::all = {
-    {
-        Patterns::crystals[0],
-        Patterns::crystals[1],
-        Patterns::crystals[2],
-        Patterns::crystals[3],
-        Patterns::cubes[0],
-        Patterns::cubes[1],
-        std::make_shared<Tunnel>(6),
-        std::make_shared<Alley<5>>(7)
-    }
-};
+const std::array<std::shared_ptr<IObstaclePattern>, Patterns::CRYSTALS> &Patterns::crystals()
+{
+    static const std::array<std::shared_ptr<IObstaclePattern>, CRYSTALS> crystals = {
+        {
+            std::make_shared<Crystal<1, 2>>(0),
+            std::make_shared<Crystal<1, 4>>(1),
+            std::make_shared<Crystal<2, 4>>(2),
+            std::make_shared<Crystal<3, 8>>(3)
+        }
+    };
+
+    return crystals;
+}
+
+const std::array<std::shared_ptr<IObstaclePattern>, Patterns::CUBES> &Patterns::cubes()
+{
+    static const std::array<std::shared_ptr<IObstaclePattern>, CUBES> cubes = {
+        {
+            std::make_shared<Cube<1>>(4),
+            std::make_shared<Cube<2>>(5)
+        }
+    };
+
+    return cubes;
+}
+
+const std::array<std::shared_ptr<IObstaclePattern>, Patterns::ALL> &Patterns::all()
+{
+    static const std::array<std::shared_ptr<IObstaclePattern>, ALL> all = {
+        {
+            crystals()[0],
+            crystals()[1],
+            crystals()[2],
+            crystals()[3],
+            cubes()[0],
+            cubes()[1],
+            std::make_shared<Tunnel>(6),
+            std::make_shared<Alley<5>>(7)
+        }
+    };
+
+    return all;
+}
@@ -0,0 +1,302 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include "PerfRunner.h"
+#include "Game.h"
+#include "PlaneControl.h"
+#include "util/CGUITTFont.h"
+#include "util/i18n.h"
+#include "util/MemoryStats.h"
+#include "util/options.h"
+
+constexpr unsigned int TICK = 1000.0f / 60.0f;
+
+PerfRunner::PerfRunner(IrrlichtDevice &device, const ConfigData &configuration) :
+    m_device(device), m_configuration(configuration) {}
+
+std::vector<PerfRunner::Scenario> PerfRunner::scenarios()
+{
+    return {
+        { "render-1000",   1, 1000, 1.0f, CAMERA_DISTANCE, 30 },
+        { "render-2000",   1, 2000, 1.0f, CAMERA_DISTANCE, 30 },
+        { "render-3000",   1, 3000, 1.0f, CAMERA_DISTANCE, 30 },
+        { "density-0.5",   1, 2000, 0.5f, CAMERA_DISTANCE, 30 },
+        { "density-1.5",   1, 2000, 1.5f, CAMERA_DISTANCE, 30 },
+        { "camera-far",    1, 2000, 1.0f, 600,             30 },
+    };
+}
+
+// weaves left and right while climbing and diving, changes every two seconds
+ControlState PerfRunner::scriptedControls(std::size_t tick)
+{
+    static const ControlState script[] = {
+        0,
+        1 << CONTROL::LEFT,
+        (1 << CONTROL::LEFT) | (1 << CONTROL::UP),
+        1 << CONTROL::CCW_ROLL,
+        0,
+        1 << CONTROL::RIGHT,
+        (1 << CONTROL::RIGHT) | (1 << CONTROL::DOWN),
+        1 << CONTROL::CW_ROLL
+    };
+
+    return script[(tick / 120) % (sizeof(script) / sizeof(script[0]))];
+}
+
+PerfRunner::Result PerfRunner::runScenario(const Scenario &scenario, const std::string &replayFile)
+{
+    Result result;
+
+    InputReplay input;
+    const bool replaying = !replayFile.empty() && input.open(replayFile);
+    std::vector<ControlState> recordedTicks;
+    std::size_t recordedTick = 0;
+    std::uint32_t recordedStep;
+
+    // the recorded controls only make sense in the recorded world
+    result.seed = replaying ? input.seed() : scenario.seed;
+
+    auto generationStart = std::chrono::steady_clock::now();
+    auto chunkDB = Game::generateChunkDB(result.seed, scenario.density);
+    result.generationTime = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - generationStart).count();
+
+    ConfigData configuration = m_configuration;
+    configuration.renderDistance = scenario.renderDistance;
+
+    auto world = std::make_unique<World>(m_device, configuration, *chunkDB);
+    world->setCameraDistance(scenario.cameraDistance);
+    PlaneControl planeControl(world->plane(), configuration.controls);
+
+    video::IVideoDriver &driver = *m_device.getVideoDriver();
+    const std::size_t ticks = scenario.seconds * 1000 / TICK;
+    std::size_t pairsSum = 0;
+
+    Profiler::getInstance().discardFrame(); // keeps the setup out of the first frame
+    for (std::size_t tick = 0; tick < ticks && m_device.run(); tick++) {
+        world->stepSimulation(TICK / 1000.0f, 10, TICK / 1000.0f);
+        if (world->gameOver()) {
+            result.crashed = true;
+            break;
+        }
+
+        ControlState controls = scriptedControls(tick);
+        if (replaying) {
+            while (recordedTick >= recordedTicks.size() && input.nextFrame(recordedStep, recordedTicks))
+                recordedTick = 0;
+            controls = recordedTick < recordedTicks.size() ? recordedTicks[recordedTick++] : 0;
+        }
+
+        {
+            ScopedTimer timer(Stage::GENERATION);
+            world->generate();
+        }
+        {
+            ScopedTimer timer(Stage::INPUT);
+            planeControl.handle(controls);
+        }
+
+        driver.beginScene(true, true, DEFAULT_COLOR);
+        world->render(DEFAULT_COLOR);
+        driver.endScene();
+
+        Profiler::getInstance().endFrame();
+        for (std::size_t i = 0; i < STAGE_COUNT; i++)
+            result.stages[i].push_back(Profiler::getInstance().last(static_cast<Stage>(i)));
+
+        std::size_t trackedMemory = 0;
+        for (std::size_t bytes : MemoryStats::snapshot().bytes)
+            trackedMemory += bytes;
+
+        result.peakObstacles = std::max(result.peakObstacles, world->obstacles());
+        result.peakTrackedMemory = std::max(result.peakTrackedMemory, trackedMemory);
+        result.peakPairs = std::max(result.peakPairs, world->pairs());
+        pairsSum += world->pairs();
+        result.frames++;
+    }
+
+    if (result.frames > 0)
+        result.averagePairs = static_cast<double>(pairsSum) / result.frames;
+
+    world.reset();
+    return result;
+}
+
+std::vector<float> PerfRunner::runTextBenchmark(bool batched)
+{
+    gui::IGUIEnvironment &guiEnvironment = *m_device.getGUIEnvironment();
+    video::IVideoDriver &driver = *m_device.getVideoDriver();
+    auto *font = dynamic_cast<gui::CGUITTFont *>(guiEnvironment.getSkin()->getFont());
+    if (batched && !font)
+        Log::getInstance().warning("perf: the skin font isn't a TrueType font, texts won't be batched");
+
+    // the texts are drawn through their parent and not with drawAll,
+    //      so the rest of the GUI doesn't get in the way
+    gui::IGUIElement *screen = guiEnvironment.addStaticText(L"", core::rect<s32>(0, 0, 820, 10 + 24*TEXT_ROWS));
+    for (u32 column = 0; column < TEXT_COLUMNS; column++)
+        for (u32 row = 0; row < TEXT_ROWS; row++) {
+            const s32 left = 10 + column*410;
+            const s32 top = 10 + row*24;
+            gui::IGUIStaticText *text = guiEnvironment.addStaticText(
+                        L"Linear velocity: 1234.56; Angular velocity: 1.23",
+                        core::rect<s32>(left, top, left + 400, top + 20), false, true, screen);
+            text->setBackgroundColor(video::SColor(120, 255, 255, 255));
+        }
+
+    std::vector<float> frames;
+    frames.reserve(TEXT_FRAMES);
+    for (u32 frame = 0; frame < TEXT_FRAMES && m_device.run(); frame++) {
+        driver.beginScene(true, true, DEFAULT_COLOR);
+
+        auto start = std::chrono::steady_clock::now();
+        if (batched && font)
+            font->beginBatch();
+        screen->draw();
+        if (batched && font)
+            font->endBatch();
+        frames.push_back(std::chrono::duration<float, std::milli>(
+                             std::chrono::steady_clock::now() - start).count());
+
+        driver.endScene();
+    }
+
+    screen->remove();
+    return frames;
+}
+
+static float percentile(std::vector<float> samples, float p)
+{
+    if (samples.empty())
+        return 0;
+
+    auto nth = samples.begin() + static_cast<std::size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+// quoted JSON string, paths on Windows are full of backslashes
+static std::string jsonString(const std::string &text)
+{
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+
+    return result + "\"";
+}
+
+static void writePercentiles(std::ostream &out, const std::vector<float> &samples)
+{
+    out << "{ "
+        << "\"p50\": " << percentile(samples, 0.5f) << ", "
+        << "\"p90\": " << percentile(samples, 0.9f) << ", "
+        << "\"p99\": " << percentile(samples, 0.99f) << ", "
+        << "\"max\": " << percentile(samples, 1.0f) << " }";
+}
+
+bool PerfRunner::run(const std::string &outputFile, const std::string &replayFile)
+{
+    std::ofstream out(outputFile);
+    if (!out.is_open()) {
+        Log::getInstance().warning("unable to open file\"", outputFile, "\" for writing.");
+        return false;
+    }
+
+    out << "{\n  \"build\": " << jsonString(PLAINE_BUILD_ID) << ",\n"
+        << "  \"replay\": " << jsonString(replayFile) << ",\n"
+        << "  \"tick_ms\": " << TICK << ",\n"
+        << "  \"scenarios\": [";
+
+    const std::vector<Scenario> all = scenarios();
+    for (std::size_t i = 0; i < all.size(); i++) {
+        const Scenario &scenario = all[i];
+        Log::getInstance().notice("perf: running scenario \"", scenario.name, "\"");
+        const Result result = runScenario(scenario, replayFile);
+
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\n"
+            << "      \"name\": " << jsonString(scenario.name) << ",\n"
+            << "      \"seed\": " << result.seed << ",\n"
+            << "      \"render_distance\": " << scenario.renderDistance << ",\n"
+            << "      \"density\": " << scenario.density << ",\n"
+            << "      \"camera_distance\": " << scenario.cameraDistance << ",\n"
+            << "      \"seconds\": " << scenario.seconds << ",\n"
+            << "      \"frames\": " << result.frames << ",\n"
+            << "      \"crashed\": " << (result.crashed ? "true" : "false") << ",\n"
+            << "      \"generation_ms\": " << result.generationTime << ",\n"
+            << "      \"peak_obstacles\": " << result.peakObstacles << ",\n"
+            << "      \"peak_tracked_bytes\": " << result.peakTrackedMemory << ",\n"
+            << "      \"peak_pairs\": " << result.peakPairs << ",\n"
+            << "      \"average_pairs\": " << result.averagePairs << ",\n"
+            << "      \"stages\": {";
+
+        for (std::size_t stage = 0; stage < STAGE_COUNT; stage++) {
+            const std::vector<float> &samples = result.stages[stage];
+            out << (stage == 0 ? "\n" : ",\n")
+                << "        " << jsonString(Profiler::stageName(static_cast<Stage>(stage))) << ": ";
+            writePercentiles(out, samples);
+        }
+
+        out << "\n      }\n    }";
+    }
+
+    out << "\n  ]\n}\n";
+
+    Log::getInstance().notice("perf: results written to \"", outputFile, "\"");
+    return out.good();
+}
+
+bool PerfRunner::runText(const std::string &outputFile)
+{
+    std::ofstream out(outputFile);
+    if (!out.is_open()) {
+        Log::getInstance().warning("unable to open file\"", outputFile, "\" for writing.");
+        return false;
+    }
+
+    Log::getInstance().notice("perf: drawing texts");
+    const std::vector<float> unbatched = runTextBenchmark(false);
+    const std::vector<float> batched = runTextBenchmark(true);
+
+    const std::wstring driverName = m_device.getVideoDriver()->getName();
+    out << "{\n  \"build\": " << jsonString(PLAINE_BUILD_ID) << ",\n"
+        << "  \"driver\": " << jsonString(wide_to_utf8(driverName)) << ",\n"
+        << "  \"texts\": " << TEXT_COLUMNS*TEXT_ROWS << ",\n"
+        << "  \"frames\": " << batched.size() << ",\n"
+        << "  \"unbatched\": ";
+    writePercentiles(out, unbatched);
+    out << ",\n  \"batched\": ";
+    writePercentiles(out, batched);
+    out << "\n}\n";
+
+    Log::getInstance().notice("perf: results written to \"", outputFile, "\"");
+    return out.good();
+}
@@ -33,6 +33,24 @@ PlaneControl::PlaneControl(Plane &plane, const Controls &controls) :
 // move the plane according to keys pressed
 void PlaneControl::handle(EventReceiver &eventReceiver)
 {
+    handle(read(eventReceiver));
+}
+
+ControlState PlaneControl::read(const EventReceiver &eventReceiver) const
+{
+    ControlState state = 0;
+    for (std::size_t i = 0; i < CONTROLS_COUNT; i++)
+        if (controls[i] != KEY_KEY_CODES_COUNT && eventReceiver.isKeyDown(controls[i]))
+            state |= 1 << i;
+
+    return state;
+}
+
+// move the plane according to controls pressed
+void PlaneControl::handle(ControlState state)
+{
+    auto pressed = [state](std::size_t control) { return (state & (1 << control)) != 0; };
+
     btVector3 axis;
     btScalar angle;
     plane.getAxisAngleRotation(axis, angle);
@@ -45,8 +63,8 @@ void PlaneControl::handle(EventReceiver &eventReceiver)
 
     // turn up and down
     {
-        bool up = eventReceiver.isKeyDown(controls[CONTROL::UP]);
-        bool down = eventReceiver.isKeyDown(controls[CONTROL::DOWN]);
+        bool up = pressed(CONTROL::UP);
+        bool down = pressed(CONTROL::DOWN);
 
         if (up && down)
             up = down = false;
@@ -67,8 +85,8 @@ void PlaneControl::handle(EventReceiver &eventReceiver)
 
     // turn left and right
     {
-        bool left = eventReceiver.isKeyDown(controls[CONTROL::LEFT]);
-        bool right = eventReceiver.isKeyDown(controls[CONTROL::RIGHT]);
+        bool left = pressed(CONTROL::LEFT);
+        bool right = pressed(CONTROL::RIGHT);
 
         if (left && right)
             left = right = false;
@@ -88,8 +106,8 @@ void PlaneControl::handle(EventReceiver &eventReceiver)
 
     // rool ccw and cw
     {
-        bool ccw = eventReceiver.isKeyDown(controls[CONTROL::CCW_ROLL]);
-        bool cw = eventReceiver.isKeyDown(controls[CONTROL::CW_ROLL]);
+        bool ccw = pressed(CONTROL::CCW_ROLL);
+        bool cw = pressed(CONTROL::CW_ROLL);
 
         if (ccw && cw)
             ccw = cw = false;
@@ -54,14 +54,13 @@ btScalar PlaneProducer::getMass() const
 std::unique_ptr<scene::ISceneNode> PlaneProducer::createNode(IrrlichtDevice &irrlichtDevice,
                                                      const btTransform &absoluteTransform) const
 {
-    std::unique_ptr<scene::IMesh> mesh(irrlichtDevice.getSceneManager()->getMesh(PLANE_MODEL));
+    std::unique_ptr<scene::IMesh> mesh(AssetCache::getInstance().mesh(irrlichtDevice, PLANE_MODEL));
 
     std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->
                                             addMeshSceneNode(mesh.release()));
     node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
     node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
-    node->setMaterialTexture(0, irrlichtDevice.getVideoDriver()->
-                             getTexture("media/textures/plane.png"));
+    node->setMaterialTexture(0, AssetCache::getInstance().texture(irrlichtDevice, "media/textures/plane.png"));
     node->setScale({ 15, 15, 15 });
 
     return node;
@@ -69,7 +68,12 @@ std::unique_ptr<scene::ISceneNode> PlaneProducer::createNode(IrrlichtDevice &irr
 
 std::unique_ptr<btCollisionShape> PlaneProducer::createShape() const
 {
-    ObjMesh objMesh(PLANE_MODEL, 15);
+    return std::make_unique<btConvexTriangleMeshShape>(binaryMesh().getTriangleMesh(15).release());
+}
+
+const BinaryMesh &PlaneProducer::binaryMesh()
+{
+    static const BinaryMesh mesh(PLANE_MODEL);
 
-    return std::make_unique<btConvexTriangleMeshShape>(objMesh.getTriangleMesh().release());
+    return mesh;
 }
@@ -0,0 +1,265 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "ScoreStore.h"
+
+constexpr char ScoreStore::MAGIC[4];
+constexpr std::uint32_t ScoreStore::VERSION;
+constexpr std::size_t ScoreStore::TOP_SIZE;
+
+static std::uint32_t fnv1a(const char *data, std::size_t size, std::uint32_t hash = 2166136261u)
+{
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+ScoreStore &ScoreStore::getInstance()
+{
+    static ScoreStore instance(SCORE_FILE, LEGACY_SCORE_FILE);
+
+    return instance;
+}
+
+ScoreStore::ScoreStore(const std::string &filename, const std::string &legacyFilename) :
+    m_filename(filename)
+{
+    m_top.reserve(TOP_SIZE + 1);
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        if (std::ifstream(filename).good()) {
+            Log::getInstance().warning("score file \"", filename, "\" is empty.");
+            create({});
+        } else {
+            // the scores of older versions
+            std::vector<s32> scores;
+            if (std::ifstream(legacyFilename).good())
+                scores = Scoreboard::loadScore(legacyFilename);
+
+            if (create(scores) && !scores.empty())
+                Log::getInstance().notice("imported ", scores.size(), " scores from \"", legacyFilename, "\"");
+        }
+
+        return;
+    }
+
+    const std::size_t valid = scan(file, [this](const RunRecord &record) {
+        index(record);
+        m_size++;
+    });
+    if (valid == 0) {
+        // keep the file for whoever can read it and start a new one
+        const std::string backup = filename + ".bak";
+        Log::getInstance().warning("score file \"", filename, "\" is of an incompatible format, moving it to \"",
+                                   backup, "\".");
+        file.close();
+
+        std::remove(backup.c_str());
+        if (std::rename(filename.c_str(), backup.c_str()) != 0)
+            Log::getInstance().warning("unable to move score file \"", filename, "\" to \"", backup, "\".");
+        else
+            create({});
+        return;
+    }
+
+    if (valid < file.size()) {
+        // rewrite the file without the torn record
+        Log::getInstance().warning("score file \"", filename, "\" is damaged, dropping its last ",
+                                   file.size() - valid, " bytes.");
+
+        const std::string temporary = filename + ".tmp";
+        std::ofstream copy(temporary, std::ios::binary);
+        copy.write(file.data(), valid);
+        copy.close();
+        file.close();
+
+        if (!copy || std::remove(filename.c_str()) != 0 || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            Log::getInstance().warning("unable to repair score file \"", filename, "\".");
+            return;
+        }
+    } else
+        file.close();
+
+    m_log.open(filename, std::ios::binary | std::ios::app);
+    if (!m_log.is_open())
+        Log::getInstance().warning("unable to open file\"", filename, "\" for writing.");
+}
+
+std::size_t ScoreStore::scan(const MappedFile &file, const std::function<void(const RunRecord &)> &f)
+{
+    Header header;
+    if (file.size() < sizeof(header))
+        return 0;
+
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!std::equal(header.magic, header.magic + 4, MAGIC) || header.version != VERSION)
+        return 0;
+
+    std::size_t position = sizeof(header);
+    while (file.size() - position >= sizeof(std::uint32_t)) {
+        std::uint32_t size, checksum;
+        std::memcpy(&size, file.data() + position, sizeof(size));
+        if (size < sizeof(s32) || file.size() - position - sizeof(size) < std::size_t(size) + sizeof(checksum))
+            break;
+
+        std::memcpy(&checksum, file.data() + position + sizeof(size) + size, sizeof(checksum));
+        if (checksum != fnv1a(file.data() + position, sizeof(size) + size))
+            break;
+
+        RunRecord record;
+        std::memcpy(&record, file.data() + position + sizeof(size), std::min<std::size_t>(size, sizeof(record)));
+        record.build[sizeof(record.build) - 1] = '\0';
+        f(record);
+
+        position += sizeof(size) + size + sizeof(checksum);
+    }
+
+    return position;
+}
+
+bool ScoreStore::create(const std::vector<s32> &scores)
+{
+    m_log.open(m_filename, std::ios::binary | std::ios::trunc);
+    if (!m_log.is_open()) {
+        Log::getInstance().warning("unable to open file\"", m_filename, "\" for writing.");
+        return false;
+    }
+
+    Header header {};
+    std::copy(MAGIC, MAGIC + 4, header.magic);
+    header.version = VERSION;
+    m_log.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (s32 score : scores) {
+        RunRecord record;
+        record.score = score;
+        append(record);
+        index(record);
+        m_size++;
+    }
+    m_log.flush();
+
+    return true;
+}
+
+void ScoreStore::append(const RunRecord &record)
+{
+    char buffer[sizeof(std::uint32_t) + sizeof(RunRecord) + sizeof(std::uint32_t)];
+    const std::uint32_t size = sizeof(record);
+    std::memcpy(buffer, &size, sizeof(size));
+    std::memcpy(buffer + sizeof(size), &record, sizeof(record));
+    const std::uint32_t checksum = fnv1a(buffer, sizeof(size) + sizeof(record));
+    std::memcpy(buffer + sizeof(size) + sizeof(record), &checksum, sizeof(checksum));
+
+    m_log.write(buffer, sizeof(buffer));
+}
+
+static bool better(const RunRecord &a, const RunRecord &b)
+{
+    return a.score > b.score;
+}
+
+void ScoreStore::index(const RunRecord &record)
+{
+    auto position = std::upper_bound(m_top.begin(), m_top.end(), record, better);
+    if (position != m_top.end() || m_top.size() < TOP_SIZE) {
+        m_top.insert(position, record);
+        if (m_top.size() > TOP_SIZE)
+            m_top.pop_back();
+    }
+
+    // runs imported from the old scoreboard have no seed and no frame times
+    if (record.duration == 0)
+        return;
+
+    auto seed = m_seeds.find(record.seed);
+    if (seed == m_seeds.end())
+        m_seeds.emplace(record.seed, SeedBest { record.seed, record.score, 1 });
+    else {
+        seed->second.score = std::max(seed->second.score, record.score);
+        seed->second.runs++;
+    }
+
+    if (record.averageFrame > 0)
+        m_frameTimes[{ record.renderDistance, record.build }].times.push_back(record.averageFrame);
+}
+
+std::size_t ScoreStore::add(const RunRecord &record)
+{
+    if (m_log.is_open()) {
+        append(record);
+        m_log.flush();
+    }
+
+    const std::size_t place = std::upper_bound(m_top.begin(), m_top.end(), record, better) - m_top.begin() + 1;
+    index(record);
+    m_size++;
+
+    return place;
+}
+
+std::vector<RunRecord> ScoreStore::top(std::size_t offset, std::size_t count) const
+{
+    if (offset >= m_top.size())
+        return {};
+
+    const std::size_t end = std::min(m_top.size(), offset + count);
+    return std::vector<RunRecord>(m_top.begin() + offset, m_top.begin() + end);
+}
+
+std::vector<ScoreStore::SeedBest> ScoreStore::bestPerSeed(std::size_t count) const
+{
+    std::vector<SeedBest> result;
+    for (const auto &seed : m_seeds)
+        if (seed.second.runs > 1)
+            result.push_back(seed.second);
+
+    std::sort(result.begin(), result.end(), [](const SeedBest &a, const SeedBest &b) {
+        return a.runs > b.runs || (a.runs == b.runs && a.score > b.score);
+    });
+    if (result.size() > count)
+        result.resize(count);
+
+    return result;
+}
+
+std::vector<ScoreStore::ConfigFrames> ScoreStore::framesPerConfig() const
+{
+    std::vector<ConfigFrames> result;
+    for (auto &config : m_frameTimes) {
+        // usually only the runs added since the last query are unsorted
+        std::vector<float> &frames = config.second.times;
+        const auto sorted = frames.begin() + config.second.sorted;
+        std::sort(sorted, frames.end());
+        std::inplace_merge(frames.begin(), sorted, frames.end());
+        config.second.sorted = frames.size();
+
+        auto percentile = [&frames](float p) { return frames[static_cast<std::size_t>(p * (frames.size() - 1))]; };
+
+        result.push_back({ config.first.first, config.first.second, frames.size(),
+                           percentile(0.5f), percentile(0.9f), percentile(0.99f) });
+    }
+
+    return result;
+}
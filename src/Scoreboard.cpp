@@ -18,125 +18,34 @@
 
 using namespace irr;
 
-// parses the file into items like string, numbers etc.
-// uses a simple deterministic finite automaton
-std::vector<Scoreboard::Item> Scoreboard::parse(const std::string &filename)
-{
-    std::ifstream inputFile(filename);
-    if (!inputFile.is_open()) {
-        std::cerr << "Error: unable to open file\"" << filename << "\" for reading" << std::endl;
-        return std::vector<Item>();
-    }
-
-    std::vector<Item> items;
-    std::string str;
-    int back = 0;
-
-    enum { NONE, INT, } state = NONE;
-    while (inputFile) {
-        int c = back ? back : inputFile.get();
-        back = 0;
-        switch (state) {
-        case NONE:
-            if (c == '\n') {
-                items.push_back(Item(Item::NEWLINE));
-            } else if (c == '#') {
-                items.push_back(Item(Item::OP_SHARP));
-            } else if (isspace(c)) {
-                // nothing
-            } else if (isdigit(c)) {
-                str.push_back(c);
-                state = INT;
-            } else if (c == EOF) {
-                break;
-            } else {
-                std::cerr << "Error: config \"" << filename << "\" is invalid." << std::endl;
-                return std::vector<Item>();
-            }
-            break;
-
-        case INT:
-            if (isdigit(c)) {
-                str.push_back(c);
-            } else {
-                back = c;
-                items.push_back(Item(Item::INT, (s32) std::stoi(str)));
-                str.clear();
-                state = NONE;
-            }
-            break;
-        }
-    }
-
-    if (items.back().type != Item::NEWLINE)
-        items.push_back(Item(Item::NEWLINE));
-
-    return items;
-}
-
-void Scoreboard::error(Item::ItemType expected, Item::ItemType found)
-{
-    std::cout << "Error: " + Item::typeToString(expected) + " expected, but " +
-        Item::typeToString(found) + " found." << std::endl;
-}
-
-// throws an error if we encounter something we don't want
-#define \
-EXPECT(_expected) {\
-    if (i->type != _expected) {\
-        error(_expected, i->type);\
-        goToNextNEWLINE = true;\
-        state = NONE;\
-        break;\
-    }\
-}
-
-// loads score infotmation from file
-// uses another simple deterministic finit automaton
+// loads score information from file
+// the file is mapped and parsed in one pass, invalid lines are skipped
 std::vector<s32> Scoreboard::loadScore(const std::string &filename)
 {
     std::vector<s32> data;
 
-    std::vector<Item> items = parse(filename);
-
-     //print items (for debug purposes)
-     /*for (const Item &item : items) {
-        if (item.type == Item::INT)
-            std::cout << "INT: " << (int) item.getInt() << std::endl;
-        else if (item.type == Item::OP_SHARP)
-            std::cout << "OP_SHARP" << std::endl;
-        else if (item.type == Item::NEWLINE)
-            std::cout << "NEWLINE" << std::endl;
-    }*/
-
-    bool goToNextNEWLINE = false;
-    enum { NONE, SCORE } state = NONE;
-
-    for (std::vector<Item>::const_iterator i = items.cbegin(); i != items.cend(); ++i) {
-        if (goToNextNEWLINE) {
-            if (i->type == Item::NEWLINE)
-                goToNextNEWLINE = false;
-        } else {
-            switch (state) {
-            case NONE:
-                EXPECT(Item::OP_SHARP);
-                if (i->type == Item::OP_SHARP)
-                    state = SCORE;
-                break;
-            case SCORE: {
-
-                EXPECT(Item::INT);
-                ++i;
-                EXPECT(Item::INT);
-                data.push_back(i->getInt());
-                ++i;
-                EXPECT(Item::NEWLINE);
+    MappedFile file;
+    if (!file.open(filename)) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for reading.");
+        return data;
+    }
 
-                state = NONE;
-                break;
-            }
-            }
+    Tokenizer tokenizer(file.data(), file.data() + file.size());
+    for (Token token = tokenizer.next(); token.type != Token::END; token = tokenizer.next()) {
+        if (token.type == Token::NEWLINE)
+            continue;
+
+        Token place, score, end;
+        if (token.type != Token::OP_SHARP ||
+                (place = tokenizer.next()).type != Token::INT ||
+                (score = tokenizer.next()).type != Token::INT ||
+                ((end = tokenizer.next()).type != Token::NEWLINE && end.type != Token::END)) {
+            Log::getInstance().warning("score file \"", filename, "\" is invalid in line ", tokenizer.line(), ".");
+            tokenizer.skipLine();
+            continue;
         }
+
+        data.push_back(score.intValue);
     }
 
     return data;
@@ -148,7 +57,7 @@ void Scoreboard::saveScore(const std::string &filename, const std::vector<s32> &
 {
     std::ofstream outputFile(filename);
     if (!outputFile.is_open()) {
-        std::cerr << "Error: unable to open file\"" << filename << "\" for writing" << std::endl;
+        Log::getInstance().warning("unable to open file\"", filename, "\" for writing.");
         return;
     }
 
@@ -17,6 +17,7 @@
 #include "World.h"
 
 void checkCollisions(btDynamicsWorld *physicsWorld, btScalar timeStep);
+void substepFinished(btDynamicsWorld *physicsWorld, btScalar timeStep);
 
 World::World(IrrlichtDevice &irrlichtDevice, const ConfigData &configuration,
              const ChunkDB &chunkDB) :
@@ -38,6 +39,7 @@ World::World(IrrlichtDevice &irrlichtDevice, const ConfigData &configuration,
                 (m_dispatcher.get(), m_broadphase.get(),
                  m_solver.get(), m_collisionConfiguration.get());
         m_physicsWorld->setInternalTickCallback(&checkCollisions, static_cast<void *>(this), true);
+        m_physicsWorld->setInternalTickCallback(&substepFinished, static_cast<void *>(this), false);
         m_physicsWorld->setGravity({ 0, 0, 0 });
 
         m_plane = PlaneProducer().producePlane(*m_physicsWorld, m_irrlichtDevice);
@@ -90,25 +92,31 @@ World::~World()
 
 void World::render(video::SColor color)
 {
+    {
+        ScopedTimer timer(Stage::RENDER_SYNC);
+
 #if FOG_ENABLED && IRIDESCENT_FOG
-    m_irrlichtDevice.getVideoDriver()->setFog(color, video::EFT_FOG_LINEAR,
-                                              m_configuration.renderDistance - 300,
-                                              m_configuration.renderDistance, 0.01f, true, true);
+        m_irrlichtDevice.getVideoDriver()->setFog(color, video::EFT_FOG_LINEAR,
+                                                  m_configuration.renderDistance - 300,
+                                                  m_configuration.renderDistance, 0.01f, true, true);
 #endif // FOG_ENABLED && IRIDESCENT_FOG
 
 #if IRIDESCENT_LIGHT
-    video::SLight lightData = m_light.getLightData();
-    lightData.DiffuseColor = color;
-    lightData.AmbientColor = color;
-    m_light.setLightData(lightData);
+        video::SLight lightData = m_light.getLightData();
+        lightData.DiffuseColor = color;
+        lightData.AmbientColor = color;
+        m_light.setLightData(lightData);
 #endif // IRIDESCENT_LIGHT
 
 #if DEBUG_DRAWER_ENABLED
-    m_physicsWorld->debugDrawWorld();
+        m_physicsWorld->debugDrawWorld();
 #endif // DEBUG_DRAWER_ENABLED
 
-    if (!m_gameOver)
-        updateCameraAndListener(); // update camera position, target, and rotation
+        if (!m_gameOver)
+            updateCameraAndListener(); // update camera position, target, and rotation
+    }
+
+    ScopedTimer timer(Stage::SCENE_DRAW);
     m_irrlichtDevice.getSceneManager()->drawAll();
 }
 
@@ -117,9 +125,15 @@ void World::stepSimulation(btScalar timeStep, int maxSubSteps, btScalar fixedTim
     m_explosion->setPosition(m_plane->getPosition());
     m_gameOver = m_plane->exploded();
 
+    ScopedTimer timer(Stage::SIMULATION);
     m_physicsWorld->stepSimulation(timeStep, maxSubSteps, fixedTimeStep);
+    // bodies can't be replaced during the step
+    m_generator->breakApart(m_breaking);
+    m_breaking.clear();
+    m_collisionAudio.flush(timeStep);
 
-    Log::getInstance().debug("simulation step = ", timeStep, "ms");
+    if (Log::enabled(severity_level::debug))
+        Log::getInstance().debug("simulation step = ", timeStep, "ms");
 }
 
 void World::generate()
@@ -143,6 +157,27 @@ std::size_t World::obstacles() const
     return m_generator->obstacles();
 }
 
+std::size_t World::pairs() const
+{
+    return m_broadphase->getOverlappingPairCache()->getNumOverlappingPairs();
+}
+
+std::size_t World::obstaclesPassed() const
+{
+    return m_generator->passed();
+}
+
+std::size_t World::collisions() const
+{
+    return m_collisions;
+}
+
+void World::setCameraDistance(btScalar cameraDistance)
+{
+    m_cameraDistance = cameraDistance;
+    updateCameraAndListener();
+}
+
 Plane &World::plane()
 {
     return *m_plane;
@@ -153,8 +188,8 @@ void World::updateCameraAndListener()
     core::vector3df upVector(0, 1, 0);
     upVector.rotateXYBy(m_plane->getEulerRotationDeg().z());
 
-    m_camera.setPosition(m_plane->node().getPosition() + upVector * 0.3f * CAMERA_DISTANCE -
-                         core::vector3df(0, 0, CAMERA_DISTANCE));
+    m_camera.setPosition(m_plane->node().getPosition() + upVector * 0.3f * m_cameraDistance -
+                         core::vector3df(0, 0, m_cameraDistance));
     m_camera.setUpVector(upVector);
 
     m_camera.setTarget(m_camera.getPosition() + core::vector3df(0, 0, 1));
@@ -163,6 +198,10 @@ void World::updateCameraAndListener()
 void checkCollisions(btDynamicsWorld *physicsWorld, btScalar /* timeStep */)
 {
     World &world = *static_cast<World *>(physicsWorld->getWorldUserInfo());
+    if (TraceRecorder::getInstance().recording())
+        world.m_substepStart = TraceRecorder::Clock::now();
+
+    ScopedTimer timer(Stage::COLLISIONS);
 
     int numManifolds = physicsWorld->getDispatcher()->getNumManifolds();
 
@@ -181,33 +220,54 @@ void checkCollisions(btDynamicsWorld *physicsWorld, btScalar /* timeStep */)
         for (int j = 0; j < numContacts; j++) {
             btManifoldPoint &pt = contactManifold->getContactPoint(j);
             if (pt.getDistance() <= 0.0f && pt.getAppliedImpulse() > 0) {
+                if (pt.getAppliedImpulse() > BREAK_THRESHOLD) {
+                    for (auto obj : { objA, objB })
+                        if (obj->getUserIndex() == COMPOUND_BODY_INDEX &&
+                            std::find(world.m_breaking.begin(), world.m_breaking.end(), obj) ==
+                                world.m_breaking.end())
+                            world.m_breaking.push_back(obj);
+                }
+
                 if (plane) {
-                    Log::getInstance().debug("plane collision occured");
-                    Log::getInstance().debug("collision impulse = ", pt.getAppliedImpulse());
+                    // a contact point is new only in the step it appeared
+                    if (pt.getLifeTime() <= 1)
+                        world.m_collisions++;
+
+                    if (Log::enabled(severity_level::debug)) {
+                        Log::getInstance().debug("plane collision occured");
+                        Log::getInstance().debug("collision impulse = ", pt.getAppliedImpulse());
+                    }
 
                     if (pt.getAppliedImpulse() > EXPLOSION_THRESHOLD) {
                         world.plane().explode();
 
-                        Audio::playAt(Audio::getInstance().explosion(), pt.getPositionWorldOnA());
+                        Audio::getInstance().playAt(Effect::EXPLOSION, pt.getPositionWorldOnA());
                     } else if (!world.plane().exploded()) {
                         world.plane().addScore(-pt.getAppliedImpulse());
 
                         if (pt.getAppliedImpulse() > 50.f)
-                            Audio::playAt(Audio::getInstance().collision(),
-                                          (pt.getPositionWorldOnA() +
-                                           pt.getPositionWorldOnB()) * 0.5f,
-                                          pt.getAppliedImpulse() / EXPLOSION_THRESHOLD * 100);
+                            world.m_collisionAudio.add(objA, objB,
+                                                       (pt.getPositionWorldOnA() +
+                                                        pt.getPositionWorldOnB()) * 0.5f,
+                                                       pt.getAppliedImpulse());
                     }
                 } else {
                     if (pt.getAppliedImpulse() > 100.0f) {
-                        Audio::playAt(Audio::getInstance().collision(),
-                                      (pt.getPositionWorldOnA() +
-                                       pt.getPositionWorldOnB()) * 0.5f,
-                                      std::min(100.0f,
-                                               pt.getAppliedImpulse() / EXPLOSION_THRESHOLD * 100));
+                        world.m_collisionAudio.add(objA, objB,
+                                                   (pt.getPositionWorldOnA() +
+                                                    pt.getPositionWorldOnB()) * 0.5f,
+                                                   pt.getAppliedImpulse());
                     }
                 }
             }
         }
     }
 }
+
+// Bullet substeps are traced from the pre-tick callback to this one
+void substepFinished(btDynamicsWorld *physicsWorld, btScalar /* timeStep */)
+{
+    World &world = *static_cast<World *>(physicsWorld->getWorldUserInfo());
+    if (TraceRecorder::getInstance().recording())
+        TraceRecorder::getInstance().complete("substep", world.m_substepStart, TraceRecorder::Clock::now());
+}
@@ -0,0 +1,180 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "bodies/CompoundProducer.h"
+#include "AssetCache.h"
+
+using namespace irr;
+
+// appends source vertices transformed into the compound's local space
+static void appendMeshBuffer(scene::SMeshBuffer &target, const scene::IMeshBuffer &source,
+                             const core::matrix4 &transform, const core::matrix4 &rotation)
+{
+    if (source.getVertexType() != video::EVT_STANDARD ||
+        source.getIndexType() != video::EIT_16BIT)
+        return;
+
+    const u32 first = target.Vertices.size();
+    const auto *vertices = static_cast<const video::S3DVertex *>(source.getVertices());
+    for (u32 i = 0; i < source.getVertexCount(); i++) {
+        video::S3DVertex vertex = vertices[i];
+        transform.transformVect(vertex.Pos);
+        rotation.rotateVect(vertex.Normal);
+        target.Vertices.push_back(vertex);
+    }
+
+    const u16 *indices = source.getIndices();
+    for (u32 i = 0; i < source.getIndexCount(); i++)
+        target.Indices.push_back(first + indices[i]);
+}
+
+CompoundProducer::CompoundProducer(std::vector<std::unique_ptr<IBodyProducer>> children) :
+    m_children(std::move(children))
+{
+    btVector3 centroid(0, 0, 0);
+    for (const auto &child : m_children)
+        centroid += child->relativeTransform.getOrigin();
+    if (!m_children.empty())
+        centroid /= static_cast<btScalar>(m_children.size());
+
+    relativeTransform.setOrigin(centroid);
+    for (auto &child : m_children)
+        child->relativeTransform.getOrigin() -= centroid;
+}
+
+btScalar CompoundProducer::getMass() const
+{
+    btScalar mass = 0;
+    for (const auto &child : m_children)
+        mass += child->getMass();
+
+    return mass;
+}
+
+std::size_t CompoundProducer::breakApart(const Body &compound,
+                                         btDynamicsWorld &physicsWorld,
+                                         IrrlichtDevice &irrlichtDevice,
+                                         std::list<std::unique_ptr<Body>> &list) const
+{
+    const btTransform &compoundTransform = compound.rigidBody().getCenterOfMassTransform();
+    const btVector3 linearVelocity = compound.getLinearVelocity();
+    const btVector3 angularVelocity = compound.getAngularVelocity();
+
+    for (const auto &child : m_children) {
+        const btTransform transform = compoundTransform * child->relativeTransform;
+
+        auto body = child->produce(physicsWorld, irrlichtDevice);
+        body->rigidBody().setCenterOfMassTransform(transform);
+        body->rigidBody().getMotionState()->setWorldTransform(transform);
+
+        // every part keeps moving the way it moved being a part of the compound
+        body->setLinearVelocity(linearVelocity +
+                                angularVelocity.cross(transform.getOrigin() - compoundTransform.getOrigin()));
+        body->setAngularVelocity(angularVelocity);
+
+        list.push_back(std::move(body));
+    }
+
+    return m_children.size();
+}
+
+std::unique_ptr<scene::ISceneNode> CompoundProducer::createNode(IrrlichtDevice &irrlichtDevice,
+                                                                const btTransform &absoluteTransform) const
+{
+    scene::SMesh *mesh = new scene::SMesh();
+    std::vector<std::pair<io::path, scene::SMeshBuffer *>> buffers; // one buffer per texture
+    std::vector<const IBodyProducer *> unmerged;
+
+    for (const auto &child : m_children) {
+        scene::IMesh *childMesh = child->createMesh(irrlichtDevice);
+        if (!childMesh) {
+            unmerged.push_back(child.get());
+            continue;
+        }
+
+        core::matrix4 rotation;
+        rotation.setRotationDegrees(quatToEulerDeg(child->relativeTransform.getRotation()));
+
+        core::matrix4 transform = rotation;
+        transform.setTranslation(bullet2irrlicht(child->relativeTransform.getOrigin()));
+        {
+            core::matrix4 scale;
+            scale.setScale(child->meshScale());
+            transform *= scale;
+        }
+
+        const io::path textureName = child->textureName();
+        auto it = std::find_if(buffers.begin(), buffers.end(),
+                               [&textureName](const auto &buffer) { return buffer.first == textureName; });
+        if (it == buffers.end()) {
+            auto *buffer = new scene::SMeshBuffer();
+            if (childMesh->getMeshBufferCount() > 0)
+                buffer->Material = childMesh->getMeshBuffer(0)->getMaterial();
+            buffer->Material.setTexture(0, AssetCache::getInstance().texture(irrlichtDevice, textureName));
+            mesh->addMeshBuffer(buffer);
+            buffer->drop();
+
+            buffers.emplace_back(textureName, buffer);
+            it = buffers.end() - 1;
+        }
+
+        for (u32 i = 0; i < childMesh->getMeshBufferCount(); i++)
+            appendMeshBuffer(*it->second, *childMesh->getMeshBuffer(i), transform, rotation);
+
+        childMesh->drop();
+    }
+
+    for (auto &buffer : buffers)
+        buffer.second->recalculateBoundingBox();
+    mesh->recalculateBoundingBox();
+    mesh->setHardwareMappingHint(scene::EHM_STATIC);
+
+    std::unique_ptr<scene::ISceneNode> node(irrlichtDevice.getSceneManager()->addMeshSceneNode(mesh));
+    mesh->drop();
+
+    // bodies that can't be merged become children of the merged node
+    for (const IBodyProducer *child : unmerged)
+        child->createNode(irrlichtDevice, child->relativeTransform).release()->setParent(node.get());
+
+    node->setPosition(bullet2irrlicht(absoluteTransform.getOrigin()));
+    node->setRotation(quatToEulerDeg(absoluteTransform.getRotation()));
+    node->setVisible(TEXTURES_ENABLED);
+#ifdef FOG_ENABLED
+    node->setMaterialFlag(video::EMF_FOG_ENABLE, true);
+#endif
+    node->setMaterialFlag(video::EMF_ANISOTROPIC_FILTER, true);
+    node->setMaterialFlag(video::EMF_TRILINEAR_FILTER, true);
+    node->setMaterialFlag(video::EMF_ANTI_ALIASING, true);
+
+    return node;
+}
+
+std::unique_ptr<btCollisionShape> CompoundProducer::createShape() const
+{
+    auto shape = std::make_unique<btCompoundShape>();
+    for (const auto &child : m_children)
+        shape->addChildShape(child->relativeTransform, child->createShape().release());
+
+    return std::move(shape);
+}
+
+void CompoundProducer::finishingTouch(btRigidBody &body) const
+{
+    body.setUserIndex(COMPOUND_BODY_INDEX);
+    // ObstacleGenerator finds the producer to break the body apart
+    body.setUserPointer(const_cast<CompoundProducer *>(this));
+}
@@ -16,4 +16,9 @@
 
 #include "bodies/ConeProducer.h"
 
-ObjMesh &ConeProducer::objMesh = *new ObjMesh(CONE_MODEL);
+const BinaryMesh &ConeProducer::binaryMesh()
+{
+    static const BinaryMesh mesh(CONE_MODEL);
+
+    return mesh;
+}
@@ -16,4 +16,9 @@
 
 #include "bodies/IcosahedronProducer.h"
 
-ObjMesh &IcosahedronProducer::objMesh = *new ObjMesh(ICOSAHEDRON_MODEL);
+const BinaryMesh &IcosahedronProducer::binaryMesh()
+{
+    static const BinaryMesh mesh(ICOSAHEDRON_MODEL);
+
+    return mesh;
+}
@@ -16,4 +16,9 @@
 
 #include "bodies/Icosphere2Producer.h"
 
-ObjMesh &Icosphere2Producer::objMesh = *new ObjMesh(ICOSPHERE2_MODEL);
+const BinaryMesh &Icosphere2Producer::binaryMesh()
+{
+    static const BinaryMesh mesh(ICOSPHERE2_MODEL);
+
+    return mesh;
+}
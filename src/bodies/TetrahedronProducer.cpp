@@ -16,4 +16,9 @@
 
 #include "bodies/TetrahedronProducer.h"
 
-ObjMesh &TetrahedronProducer::objMesh = *new ObjMesh(TETRAHEDRON_MODEL);
+const BinaryMesh &TetrahedronProducer::binaryMesh()
+{
+    static const BinaryMesh mesh(TETRAHEDRON_MODEL);
+
+    return mesh;
+}
@@ -88,6 +88,7 @@ void GUI::recalculateButtonProportions()
 void GUI::initialize(unsigned screenIndex)
 {
     recalculateButtonProportions();
+    bracketedElement = nullptr;
     getCurrentScreen().terminate();
     currentScreenIndex = screenIndex;
     getCurrentScreen().initialize(buttonWidth, buttonHeight);
@@ -100,27 +101,43 @@ void GUI::initialize(unsigned screenIndex)
 
 void GUI::reload()
 {
+    // the screen sets its texts again, so the brackets are put back afterwards
+    removeBrackets();
     getCurrentScreen().reload(buttonWidth, buttonHeight);
+    updateSelection();
 }
 
+// only the brackets are moved, the screen isn't reloaded
 void GUI::updateSelection()
 {
     if (selectableElements.empty())
         return;
 
-    getCurrentScreen().reload(buttonWidth, buttonHeight);
+    removeBrackets();
 
-    if (guiEnvironment.getFocus()->getType() != gui::EGUIET_EDIT_BOX &&
-        guiEnvironment.getFocus()->getType() != gui::EGUIET_COMBO_BOX &&
-        guiEnvironment.getFocus()->getType() != gui::EGUIET_BUTTON)
+    gui::IGUIElement *focus = guiEnvironment.getFocus();
+    if (focus &&
+        focus->getType() != gui::EGUIET_EDIT_BOX &&
+        focus->getType() != gui::EGUIET_COMBO_BOX &&
+        focus->getType() != gui::EGUIET_BUTTON)
     {
+        bracketedElement = focus;
+        bracketedText = focus->getText();
+
         core::stringw str = "[";
-        str += guiEnvironment.getFocus()->getText();
+        str += bracketedText;
         str += "]";
-        guiEnvironment.getFocus()->setText(str.c_str());
+        focus->setText(str.c_str());
     }
 }
 
+void GUI::removeBrackets()
+{
+    if (bracketedElement)
+        bracketedElement->setText(bracketedText.c_str());
+    bracketedElement = nullptr;
+}
+
 void GUI::selectWithTab()
 {
     if (selectableElements.empty())
@@ -0,0 +1,55 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gui/TextBinding.h"
+
+const wchar_t *TranslatedLabel::get()
+{
+    if (m_generation != languageGeneration()) {
+        m_text = translate(m_msgid);
+        m_generation = languageGeneration();
+    }
+
+    return m_text;
+}
+
+void TextBinding::bind(gui::IGUIStaticText *element)
+{
+    m_element = element;
+    m_buffer[0] = m_shown[0] = L'\0';
+    m_length = 0;
+}
+
+bool TextBinding::active() const
+{
+    return m_element && m_element->isVisible();
+}
+
+void TextBinding::clear()
+{
+    m_length = 0;
+    m_buffer[0] = L'\0';
+}
+
+void TextBinding::commit()
+{
+    if (!m_element || std::wcscmp(m_buffer.data(), m_shown.data()) == 0)
+        return;
+
+    m_shown = m_buffer;
+    m_element->setText(m_shown.data());
+}
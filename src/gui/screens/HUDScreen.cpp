@@ -46,6 +46,25 @@ void HUDScreen::initialize(s32 buttonWidth, s32 buttonHeight)
     textScore = guiEnvironment.addStaticText(L"POINTS", core::rect<s32>(10, 10 + 24*5, 400, 30 + 24*5));
     textScore->setBackgroundColor(video::SColor(120, 255, 255, 255));
 
+    // stage timings table, one line per stage and a header
+    textProfiler = guiEnvironment.addStaticText(L"PROFILER", core::rect<s32>(10, 10 + 24*6, 400, 10 + 24*6 + 18*(STAGE_COUNT + 1)));
+    textProfiler->setBackgroundColor(video::SColor(120, 255, 255, 255));
+
+    // memory usage table
+    {
+        const s32 top = 10 + 24*6 + 18*(STAGE_COUNT + 1) + 4;
+        textMemory = guiEnvironment.addStaticText(L"MEMORY", core::rect<s32>(10, top, 400, top + 18*(MEMORY_CATEGORY_COUNT + 4)));
+        textMemory->setBackgroundColor(video::SColor(120, 255, 255, 255));
+    }
+
+    cameraPosition.bind(textCameraPosition);
+    obstaclesCount.bind(textObstaclesCount);
+    fps.bind(textFPS);
+    velocity.bind(textVelocity);
+    angle.bind(textAngle);
+    score.bind(textScore);
+    profiler.bind(textProfiler);
+
     reload(buttonWidth, buttonHeight);
     resize(buttonWidth, buttonHeight);
 
@@ -60,6 +79,8 @@ void HUDScreen::reload(s32 /*buttonWidth*/, s32 /*buttonHeight*/)
     textVelocity->setVisible(allVisible && infoVisible);
     textAngle->setVisible(allVisible && infoVisible);
     textScore->setVisible(allVisible && infoVisible);
+    textProfiler->setVisible(allVisible && infoVisible && PROFILER_ENABLED);
+    textMemory->setVisible(allVisible && infoVisible && MEMORY_STATS_ENABLED);
 }
 
 void HUDScreen::terminate()
@@ -71,6 +92,11 @@ void HUDScreen::terminate()
         textVelocity->remove();
         textAngle->remove();
         textScore->remove();
+        textProfiler->remove();
+        textMemory->remove();
+
+        for (TextBinding *binding : { &cameraPosition, &obstaclesCount, &fps, &velocity, &angle, &score, &profiler })
+            binding->bind(nullptr);
 
         initialized = false;
     }
@@ -14,6 +14,7 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstdio>
 #include "gui/screens/ScoreboardScreen.h"
 
 ScoreboardScreen::ScoreboardScreen(const ConfigData &configuration, gui::IGUIEnvironment &guiEnvironment) :
@@ -34,20 +35,56 @@ void ScoreboardScreen::initialize(s32 buttonWidth, s32 buttonHeight)
 
     tableScore->addColumn(_wp("Place"), 0);
     tableScore->addColumn(_wp("Score"), 1);
+    tableScore->addColumn(_wp("Seed"), 2);
+    tableScore->addColumn(_wp("Time"), 3);
+    tableScore->addColumn(_wp("Frame"), 4);
 
-    std::vector<s32> dataScore = Scoreboard::loadScore("score.txt");
+    const ScoreStore &store = ScoreStore::getInstance();
+    const std::vector<RunRecord> dataScore = store.top(0, PAGE_SIZE);
 
     std::string str;
 
     for (std::size_t i = 0; i < dataScore.size(); i++)
     {
+       const RunRecord &record = dataScore[i];
        str = "#" + std::to_string(i + 1);
        tableScore->addRow(i);
        tableScore->setCellText(i, 0, utf8_to_wide(str).c_str());
-       str = std::to_string(dataScore[i]);
+       str = std::to_string(record.score);
        tableScore->setCellText(i, 1, utf8_to_wide(str).c_str());
+       // runs imported from the old scoreboard have nothing else
+       if (record.duration == 0)
+           continue;
+
+       str = std::to_string(record.seed);
+       tableScore->setCellText(i, 2, utf8_to_wide(str).c_str());
+       char cell[64];
+       std::snprintf(cell, sizeof(cell), _("%u s"), record.duration / 1000);
+       tableScore->setCellText(i, 3, utf8_to_wide(cell).c_str());
+       std::snprintf(cell, sizeof(cell), _("%.1f / %.1f ms"), record.averageFrame, record.p99Frame);
+       tableScore->setCellText(i, 4, utf8_to_wide(cell).c_str());
     }
 
+    std::string statistics;
+    char line[256]; // translations take more bytes in UTF-8
+    std::size_t lines = 0;
+    for (const ScoreStore::ConfigFrames &config : store.framesPerConfig()) {
+        if (lines == STATISTICS_LINES / 2)
+            break;
+        lines++;
+        std::snprintf(line, sizeof(line), _("%s, render distance %u: %lu runs, frame %.1f / %.1f / %.1f ms (p50 / p90 / p99)\n"),
+                      config.build.c_str(), config.renderDistance, static_cast<unsigned long>(config.runs),
+                      config.p50, config.p90, config.p99);
+        statistics += line;
+    }
+    for (const ScoreStore::SeedBest &seed : store.bestPerSeed(STATISTICS_LINES - lines)) {
+        std::snprintf(line, sizeof(line), _("seed %u: best %d of %lu runs\n"),
+                      seed.seed, seed.score, static_cast<unsigned long>(seed.runs));
+        statistics += line;
+    }
+
+    textStatistics = guiEnvironment.addStaticText(utf8_to_wide(statistics).c_str(), core::rect<s32>(0, 0, 0, 0));
+
     buttonMenu = guiEnvironment.addButton(core::rect<s32>(0, 0, 0, 0));
     buttonMenu->setID(ID_BUTTON_MENU);
     setCustomButtonSkin(*buttonMenu);
@@ -75,6 +112,7 @@ void ScoreboardScreen::terminate()
 {
     if (initialized) {
         tableScore->remove();
+        textStatistics->remove();
         buttonMenu->remove();
         buttonQuit->remove();
 
@@ -84,11 +122,20 @@ void ScoreboardScreen::terminate()
 
 void ScoreboardScreen::resize(s32 buttonWidth, s32 buttonHeight)
 {
+    const s32 statisticsHeight = 2*SPACE * STATISTICS_LINES;
+    const s32 tableWidth = configuration.resolution.Width - 6*SPACE - buttonWidth;
     tableScore->setRelativePosition(core::rect<s32>(2*SPACE, SPACE,
                                                       configuration.resolution.Width - 4*SPACE - buttonWidth,
-                                                      configuration.resolution.Height - 2*SPACE));
+                                                      configuration.resolution.Height - 3*SPACE - statisticsHeight));
     tableScore->setColumnWidth(0, 6*SPACE);
-    tableScore->setColumnWidth(1, configuration.resolution.Width - 12*SPACE - buttonWidth - 1);
+    tableScore->setColumnWidth(1, (tableWidth - 6*SPACE) / 4);
+    tableScore->setColumnWidth(2, (tableWidth - 6*SPACE) / 4);
+    tableScore->setColumnWidth(3, (tableWidth - 6*SPACE) / 4);
+    tableScore->setColumnWidth(4, (tableWidth - 6*SPACE) / 4 - 1);
+    textStatistics->setRelativePosition(core::rect<s32>(2*SPACE,
+                                                        configuration.resolution.Height - 2*SPACE - statisticsHeight,
+                                                        configuration.resolution.Width - 4*SPACE - buttonWidth,
+                                                        configuration.resolution.Height - 2*SPACE));
     buttonMenu->setRelativePosition(core::rect<s32>(configuration.resolution.Width - buttonWidth - 2 * SPACE,
                                                     configuration.resolution.Height - 2 * buttonHeight - 2 * SPACE,
                                                     configuration.resolution.Width - 2 * SPACE,
@@ -109,6 +156,7 @@ std::vector<gui::IGUIElement *> ScoreboardScreen::getSelectableElements()
 void ScoreboardScreen::setVisible(bool visible)
 {
     tableScore->setVisible(visible);
+    textStatistics->setVisible(visible);
     buttonMenu->setVisible(visible);
     buttonQuit->setVisible(visible);
 }
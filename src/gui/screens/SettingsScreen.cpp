@@ -29,6 +29,7 @@ void SettingsScreen::initialize(s32 buttonWidth, s32 buttonHeight)
     guiEnvironment.getSkin()->setColor(gui::EGDC_BUTTON_TEXT,video::SColor(255,30,30,30));
 
     textScreenSize = guiEnvironment.addStaticText(L"SCREEN_SIZE", core::rect<s32>(0, 0, 0, 0));
+    screenSize.bind(textScreenSize);
 
     textVolume = guiEnvironment.addStaticText(_wp(""), core::rect<s32>(0, 0, 0, 0));
 
@@ -465,6 +465,7 @@ CGUITTFont::CGUITTFont(irr::video::IVideoDriver* driver, irr::io::IFileSystem* f
 : UseMonochrome(false), UseTransparency(true), UseHinting(false), UseAutoHinting(false)
 , Outline(0.f), OutlineColor(255, 255, 255, 255)
 , BatchLoadSize(1), Driver(driver), FileSystem(fileSystem), Logger(0), GlobalKerningWidth(0), GlobalKerningHeight(0)
+, Batching(false), BatchRunCount(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CGUITTFont");
@@ -839,6 +840,21 @@ void CGUITTFont::draw(const core::stringw& text, const core::rect<s32>& position
 	if (!UseTransparency)
 		color.color |= 0xff000000;
 
+	// collect the glyphs to be drawn by endBatch
+	if (Batching)
+	{
+		for (u32 i = 0; i < GlyphPages.size(); ++i)
+		{
+			CGUITTGlyphPage* page = GlyphPages[i];
+
+			if ( Outline != 0.f && !page->OutlineRenderPositions.empty() )
+				batchGlyphs(page, OutlineColor, true, page->OutlineRenderPositions, page->OutlineRenderSourceRects, clip);
+			if ( !page->RenderPositions.empty() )
+				batchGlyphs(page, color, false, page->RenderPositions, page->RenderSourceRects, clip);
+		}
+		return;
+	}
+
 	// draw outline if we have some
 	if ( Outline != 0.f )
 	{
@@ -1108,6 +1124,111 @@ video::ITexture* CGUITTFont::getPageTextureByIndex(u32 page_index) const
 	return 0;
 }
 
+u32 CGUITTFont::getPageTextureBytes() const
+{
+	u32 bytes = 0;
+	for (u32 i = 0; i < GlyphPages.size(); ++i)
+	{
+		const video::ITexture* texture = GlyphPages[i]->Texture;
+		if (texture)
+			bytes += texture->getSize().getArea() * video::IImage::getBitsPerPixelFromFormat(texture->getColorFormat()) / 8;
+	}
+	return bytes;
+}
+
+void CGUITTFont::prewarm(const wchar_t* characters)
+{
+	// Load exactly the given characters, not the batches around them.
+	u32 old_size = BatchLoadSize;
+	BatchLoadSize = 1;
+	for (const wchar_t* c = characters; c && *c != L'\0'; ++c)
+		getGlyphIndexByChar(*c);
+	BatchLoadSize = old_size;
+
+	// Upload everything that was loaded in one go.
+	update_glyph_pages();
+}
+
+void CGUITTFont::beginBatch()
+{
+	Batching = true;
+	BatchRunCount = 0;
+}
+
+void CGUITTFont::endBatch()
+{
+	Batching = false;
+
+	if (!Driver)
+		return;
+
+	// outlines go under all the glyphs, as they do within a single draw
+	for (u32 i = 0; i < BatchRunCount; ++i)
+	{
+		const SBatchRun& run = BatchRuns[i];
+		if (run.Outline)
+			Driver->draw2DImageBatch(run.Page->Texture, run.Positions, run.SourceRects, 0, run.Color, true);
+	}
+
+	for (u32 i = 0; i < BatchRunCount; ++i)
+	{
+		const SBatchRun& run = BatchRuns[i];
+		if (!run.Outline)
+			Driver->draw2DImageBatch(run.Page->Texture, run.Positions, run.SourceRects, 0, run.Color, true);
+	}
+
+	BatchRunCount = 0;
+}
+
+void CGUITTFont::batchGlyphs(CGUITTGlyphPage* page, video::SColor color, bool outline,
+	const core::array<core::vector2di>& positions, const core::array<core::recti>& sourceRects,
+	const core::rect<s32>* clip)
+{
+	// Find the run of this page and color, there are only a few of them.
+	SBatchRun* run = 0;
+	for (u32 i = 0; i < BatchRunCount && !run; ++i)
+	{
+		if (BatchRuns[i].Page == page && BatchRuns[i].Color == color && BatchRuns[i].Outline == outline)
+			run = &BatchRuns[i];
+	}
+
+	if (!run)
+	{
+		if (BatchRunCount == BatchRuns.size())
+			BatchRuns.push_back(SBatchRun());
+
+		run = &BatchRuns[BatchRunCount++];
+		run->Page = page;
+		run->Color = color;
+		run->Outline = outline;
+		run->Positions.set_used(0);
+		run->SourceRects.set_used(0);
+	}
+
+	for (u32 i = 0; i < positions.size(); ++i)
+	{
+		core::vector2di position = positions[i];
+		core::recti source = sourceRects[i];
+
+		// Glyphs are drawn unscaled, so the source rectangle is cut by as much as the destination is.
+		if (clip)
+		{
+			const core::recti destination(position, source.getSize());
+			core::recti clipped(destination);
+			clipped.clipAgainst(*clip);
+			if (clipped.getWidth() <= 0 || clipped.getHeight() <= 0)
+				continue;
+
+			source.UpperLeftCorner += clipped.UpperLeftCorner - destination.UpperLeftCorner;
+			source.LowerRightCorner -= destination.LowerRightCorner - clipped.LowerRightCorner;
+			position = clipped.UpperLeftCorner;
+		}
+
+		run->Positions.push_back(position);
+		run->SourceRects.push_back(source);
+	}
+}
+
 core::dimension2d<u32> CGUITTFont::getDimensionUntilEndOfLine(const wchar_t* p) const
 {
 	core::stringw s;
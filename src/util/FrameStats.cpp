@@ -0,0 +1,107 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include "util/FrameStats.h"
+#include "Log.h"
+
+constexpr std::size_t FrameStats::NO_HITCH;
+
+FrameStats::FrameStats()
+{
+    m_histogram.fill(0);
+}
+
+std::size_t FrameStats::bucket(float milliseconds)
+{
+    if (milliseconds < 0)
+        return 0;
+
+    const std::size_t result = milliseconds;
+    return result < BUCKETS ? result : BUCKETS - 1;
+}
+
+void FrameStats::addFrame(std::size_t obstacles)
+{
+    Frame &frame = m_window[m_frames % WINDOW];
+
+    // the oldest frame leaves the histogram
+    if (m_frames >= WINDOW)
+        m_histogram[bucket(frame.stages[static_cast<std::size_t>(Stage::FRAME)])]--;
+
+    for (std::size_t i = 0; i < STAGE_COUNT; i++)
+        frame.stages[i] = Profiler::getInstance().last(static_cast<Stage>(i));
+    frame.obstacles = obstacles;
+
+    const float duration = frame.stages[static_cast<std::size_t>(Stage::FRAME)];
+    const std::size_t inHistogram = m_frames < WINDOW ? m_frames : WINDOW;
+
+    if (m_pendingHitch == NO_HITCH && inHistogram >= MIN_FRAMES &&
+        duration > MIN_HITCH && duration > HITCH_FACTOR * median())
+    {
+        m_pendingHitch = m_frames;
+        m_pendingMedian = median();
+        m_hitches++;
+    }
+
+    m_histogram[bucket(duration)]++;
+    m_frames++;
+
+    if (m_pendingHitch != NO_HITCH && m_frames - m_pendingHitch > CONTEXT) {
+        dump(m_pendingHitch);
+        m_pendingHitch = NO_HITCH;
+    }
+}
+
+float FrameStats::percentile(float p) const
+{
+    const std::size_t count = m_frames < WINDOW ? m_frames : WINDOW;
+    if (count == 0)
+        return 0;
+
+    const std::size_t rank = p * (count - 1) + 1;
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; i++) {
+        seen += m_histogram[i];
+        if (seen >= rank)
+            return i + 0.5f;
+    }
+
+    return BUCKETS;
+}
+
+void FrameStats::dump(std::size_t hitch) const
+{
+    Log::getInstance().warning("hitch: frame ", hitch, " took ",
+                               m_window[hitch % WINDOW].stages[static_cast<std::size_t>(Stage::FRAME)],
+                               " ms, median is ", m_pendingMedian, " ms");
+
+    const std::size_t first = hitch >= CONTEXT ? hitch - CONTEXT : 0;
+    for (std::size_t index = first; index < m_frames && index <= hitch + CONTEXT; index++) {
+        const Frame &frame = m_window[index % WINDOW];
+
+        char line[256];
+        int length = std::snprintf(line, sizeof(line), "frame %lu: %lu obstacles",
+                                   static_cast<unsigned long>(index),
+                                   static_cast<unsigned long>(frame.obstacles));
+        for (std::size_t i = 0; i < STAGE_COUNT && length > 0 && length < static_cast<int>(sizeof(line)); i++)
+            length += std::snprintf(line + length, sizeof(line) - length, ", %s %.2f",
+                                    Profiler::stageName(static_cast<Stage>(i)), frame.stages[i]);
+
+        Log::getInstance().notice(line);
+    }
+}
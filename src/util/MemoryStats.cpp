@@ -0,0 +1,83 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdlib>
+#include <LinearMath/btAlignedAllocator.h>
+#include "util/MemoryStats.h"
+
+std::array<std::atomic<std::size_t>, MEMORY_CATEGORY_COUNT> MemoryStats::bytes {};
+std::array<std::atomic<std::size_t>, MEMORY_CATEGORY_COUNT> MemoryStats::allocations {};
+
+#if MEMORY_STATS_ENABLED
+// the size is kept in front of the block, which stays 16-byte aligned
+constexpr std::size_t HEADER_SIZE = 16;
+
+static void *bulletAlloc(std::size_t size)
+{
+    void *block = std::malloc(size + HEADER_SIZE);
+    if (!block)
+        return nullptr;
+
+    *static_cast<std::size_t *>(block) = size;
+    MemoryStats::allocated(MemoryCategory::BULLET, size);
+
+    return static_cast<char *>(block) + HEADER_SIZE;
+}
+
+static void bulletFree(void *pointer)
+{
+    if (!pointer)
+        return;
+
+    void *block = static_cast<char *>(pointer) - HEADER_SIZE;
+    MemoryStats::freed(MemoryCategory::BULLET, *static_cast<std::size_t *>(block));
+
+    std::free(block);
+}
+#endif // MEMORY_STATS_ENABLED
+
+MemoryStats::Snapshot MemoryStats::snapshot()
+{
+    Snapshot result;
+    for (std::size_t i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        result.bytes[i] = bytes[i].load(std::memory_order_relaxed);
+        result.allocations[i] = allocations[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+const char *MemoryStats::categoryName(MemoryCategory category)
+{
+    switch (category) {
+    case MemoryCategory::BULLET:
+        return "bullet";
+    case MemoryCategory::PRODUCERS:
+        return "producers";
+    case MemoryCategory::BODIES:
+        return "bodies";
+    default:
+        return "";
+    }
+}
+
+void MemoryStats::installBulletHooks()
+{
+#if MEMORY_STATS_ENABLED
+    btAlignedAllocSetCustom(&bulletAlloc, &bulletFree);
+#endif // MEMORY_STATS_ENABLED
+}
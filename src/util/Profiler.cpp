@@ -0,0 +1,122 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include "util/Profiler.h"
+
+constexpr std::size_t Profiler::WINDOW;
+
+Profiler::Profiler() :
+    m_frameStart(Clock::now())
+{
+    m_current.fill(Clock::duration::zero());
+    for (auto &history : m_history)
+        history.fill(0);
+}
+
+Profiler &Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+const char *Profiler::stageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::INPUT:
+        return "input";
+    case Stage::GENERATION:
+        return "generation";
+    case Stage::SIMULATION:
+        return "simulation";
+    case Stage::COLLISIONS:
+        return "collisions";
+    case Stage::RENDER_SYNC:
+        return "render sync";
+    case Stage::SCENE_DRAW:
+        return "scene draw";
+    case Stage::GUI_DRAW:
+        return "GUI draw";
+    case Stage::FRAME:
+        return "frame";
+    default:
+        return "";
+    }
+}
+
+void Profiler::add(Stage stage, Clock::duration duration)
+{
+    m_current[static_cast<std::size_t>(stage)] += duration;
+}
+
+void Profiler::endFrame()
+{
+    const Clock::time_point now = Clock::now();
+    m_current[static_cast<std::size_t>(Stage::FRAME)] = now - m_frameStart;
+    TraceRecorder::getInstance().complete(stageName(Stage::FRAME), m_frameStart, now);
+    m_frameStart = now;
+
+    const std::size_t slot = m_frames % WINDOW;
+    for (std::size_t i = 0; i < STAGE_COUNT; i++) {
+        m_history[i][slot] = std::chrono::duration<float, std::milli>(m_current[i]).count();
+        m_current[i] = Clock::duration::zero();
+    }
+
+    m_frames++;
+}
+
+void Profiler::discardFrame()
+{
+    m_frameStart = Clock::now();
+    m_current.fill(Clock::duration::zero());
+}
+
+float Profiler::last(Stage stage) const
+{
+    if (m_frames == 0)
+        return 0;
+
+    return m_history[static_cast<std::size_t>(stage)][(m_frames - 1) % WINDOW];
+}
+
+Profiler::Summary Profiler::summary(Stage stage) const
+{
+    Summary result;
+
+    const std::size_t count = std::min(m_frames, WINDOW);
+    if (count == 0)
+        return result;
+
+    std::array<float, WINDOW> samples = m_history[static_cast<std::size_t>(stage)];
+    auto end = samples.begin() + count;
+
+    result.min = *std::min_element(samples.begin(), end);
+    for (auto it = samples.begin(); it != end; it++)
+        result.avg += *it;
+    result.avg /= count;
+
+    auto p99 = samples.begin() + (count - 1) * 99 / 100;
+    std::nth_element(samples.begin(), p99, end);
+    result.p99 = *p99;
+
+    return result;
+}
+
+std::size_t Profiler::frames() const
+{
+    return m_frames;
+}
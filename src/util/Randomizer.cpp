@@ -16,4 +16,4 @@
 
 #include "util/Randomizer.h"
 
-std::default_random_engine Randomizer::engine { std::random_device()() };
+thread_local std::default_random_engine Randomizer::engine { std::random_device()() };
@@ -0,0 +1,182 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include "util/Tokenizer.h"
+
+bool Token::is(const char *keyword) const
+{
+    return type == KEYWORD && std::strlen(keyword) == length &&
+            std::strncmp(text, keyword, length) == 0;
+}
+
+const char *Token::typeName(Type type)
+{
+    switch (type) {
+    case INT:
+        return "integer";
+    case FLOAT:
+        return "float";
+    case STRING:
+        return "string";
+    case KEYWORD:
+        return "keyword";
+    case OP_EQUAL:
+        return "'='";
+    case OP_COMMA:
+        return "comma";
+    case OP_COLON:
+        return "':'";
+    case OP_SHARP:
+        return "'#'";
+    case NEWLINE:
+        return "new line";
+    case END:
+        return "end of file";
+    default:
+        return "invalid token";
+    }
+}
+
+Token Tokenizer::next()
+{
+    // the line is counted after the token that ended it
+    if (m_newLine) {
+        m_line++;
+        m_newLine = false;
+    }
+
+    while (m_position != m_end && *m_position != '\n' && std::isspace(static_cast<unsigned char>(*m_position)))
+        m_position++;
+
+    Token token;
+    token.text = m_position;
+    if (m_position == m_end) {
+        token.type = Token::END;
+        return token;
+    }
+
+    const char c = *m_position++;
+    token.length = 1;
+
+    switch (c) {
+    case '\n':
+        m_newLine = true;
+        token.type = Token::NEWLINE;
+        return token;
+    case '=':
+        token.type = Token::OP_EQUAL;
+        return token;
+    case ',':
+        token.type = Token::OP_COMMA;
+        return token;
+    case ':':
+        token.type = Token::OP_COLON;
+        return token;
+    case '#':
+        token.type = Token::OP_SHARP;
+        return token;
+    case '"':
+        token.text = m_position;
+        while (m_position != m_end && *m_position != '"' && *m_position != '\n')
+            m_position++;
+        token.length = m_position - token.text;
+        if (m_position == m_end || *m_position != '"') {
+            token.type = Token::INVALID;
+            return token;
+        }
+        m_position++;
+        token.type = Token::STRING;
+        return token;
+    default:
+        break;
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(c))) {
+        while (m_position != m_end && std::isalnum(static_cast<unsigned char>(*m_position)))
+            m_position++;
+        token.length = m_position - token.text;
+        token.type = Token::KEYWORD;
+        return token;
+    }
+
+    const bool negative = c == '-';
+    if (negative && (m_position == m_end || !std::isdigit(static_cast<unsigned char>(*m_position)))) {
+        token.type = Token::INVALID;
+        return token;
+    }
+    if (!negative && !std::isdigit(static_cast<unsigned char>(c))) {
+        token.type = Token::INVALID;
+        return token;
+    }
+
+    // numbers are parsed here and not by the C library, so the locale doesn't matter
+    long integer = negative ? 0 : c - '0';
+    bool overflow = false;
+    while (m_position != m_end && std::isdigit(static_cast<unsigned char>(*m_position))) {
+        const int digit = *m_position++ - '0';
+        // the rest of the digits is skipped and the number is invalid
+        if (overflow || integer > (std::numeric_limits<long>::max() - digit) / 10)
+            overflow = true;
+        else
+            integer = integer * 10 + digit;
+    }
+
+    if (overflow) {
+        while (m_position != m_end && (std::isdigit(static_cast<unsigned char>(*m_position)) || *m_position == '.'))
+            m_position++;
+        token.type = Token::INVALID;
+        token.length = m_position - token.text;
+        return token;
+    }
+
+    token.type = Token::INT;
+    token.intValue = negative ? -integer : integer;
+    token.floatValue = token.intValue;
+
+    if (m_position != m_end && *m_position == '.') {
+        m_position++;
+        float fraction = 0, scale = 1;
+        while (m_position != m_end && std::isdigit(static_cast<unsigned char>(*m_position))) {
+            fraction = fraction * 10 + (*m_position++ - '0');
+            scale *= 10;
+        }
+
+        token.type = Token::FLOAT;
+        token.floatValue = (integer + fraction / scale) * (negative ? -1 : 1);
+    }
+
+    token.length = m_position - token.text;
+    return token;
+}
+
+void Tokenizer::skipLine()
+{
+    // the last token was the line break
+    if (m_newLine)
+        return;
+
+    while (m_position != m_end && *m_position != '\n')
+        m_position++;
+
+    if (m_position != m_end) {
+        m_position++;
+        m_line++;
+    }
+}
@@ -0,0 +1,150 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <fstream>
+#include "util/TraceRecorder.h"
+#include "Log.h"
+
+TraceRecorder::TraceRecorder() :
+    m_epoch(Clock::now()) {}
+
+TraceRecorder &TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::BufferOwner::~BufferOwner()
+{
+    if (!buffer)
+        return;
+
+    TraceRecorder &recorder = TraceRecorder::getInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+
+    bool empty;
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        empty = buffer->events.empty();
+        buffer->released = true;
+    }
+
+    // a buffer with events is kept until stop writes them
+    if (empty)
+        recorder.m_buffers.remove_if([this](const ThreadBuffer &other) { return &other == buffer; });
+}
+
+TraceRecorder::ThreadBuffer &TraceRecorder::threadBuffer()
+{
+    thread_local BufferOwner owner;
+
+    if (!owner.buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffers.emplace_back();
+        owner.buffer = &m_buffers.back();
+        owner.buffer->id = m_nextId++;
+    }
+
+    return *owner.buffer;
+}
+
+void TraceRecorder::start()
+{
+    m_recording.store(true, std::memory_order_relaxed);
+    Log::getInstance().notice("trace recording started");
+}
+
+bool TraceRecorder::stop(const std::string &filename)
+{
+    m_recording.store(false, std::memory_order_relaxed);
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        Log::getInstance().warning("unable to open file\"", filename, "\" for writing.");
+        return false;
+    }
+
+    auto microseconds = [this](Clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(time - m_epoch).count();
+    };
+
+    std::size_t written = 0;
+    file << std::fixed;
+    file.precision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool first = true;
+    for (auto &buffer : m_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+
+        if (buffer.events.empty())
+            continue;
+
+        const std::string name = buffer.name.empty() ?
+                    "thread " + std::to_string(buffer.id) : buffer.name;
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.id
+             << ",\"args\":{\"name\":\"" << name << "\"}}";
+        first = false;
+
+        for (const Event &event : buffer.events) {
+            file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"plaine\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << buffer.id << ",\"ts\":" << microseconds(event.begin)
+                 << ",\"dur\":" << microseconds(event.end) - microseconds(event.begin);
+            if (event.count >= 0)
+                file << ",\"args\":{\"count\":" << event.count << "}";
+            file << "}";
+        }
+
+        written += buffer.events.size();
+        buffer.events.clear();
+    }
+
+    m_buffers.remove_if([](const ThreadBuffer &buffer) { return buffer.released; });
+
+    file << "\n]}\n";
+
+    Log::getInstance().notice("trace recording stopped, ", written, " events written to \"", filename, "\"");
+    if (const std::size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed))
+        Log::getInstance().warning(dropped, " trace events dropped");
+
+    return file.good();
+}
+
+void TraceRecorder::complete(const char *name, Clock::time_point begin, Clock::time_point end, long count)
+{
+    if (!recording())
+        return;
+
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events.push_back({ name, begin, end, count });
+}
+
+void TraceRecorder::setThreadName(const std::string &name)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
@@ -14,7 +14,52 @@
  * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstdlib>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
 #include "util/i18n.h"
+#include "util/MappedFile.h"
+
+static unsigned generation = 1;
+
+unsigned languageGeneration()
+{
+    return generation;
+}
+
+namespace {
+    struct Translation {
+        std::string msgid;
+        std::wstring text;
+    };
+
+    // msgids are nearly always literals, so they are looked up by their address
+    //      and the text is compared only to make sure the address wasn't reused
+    using TranslationCache = std::unordered_map<const char *, Translation>;
+
+    // a cache per language, so switching back and forth converts nothing
+    std::unordered_map<std::string, TranslationCache> caches;
+    TranslationCache *currentCache = nullptr;
+    unsigned cacheGeneration = 0;
+}
+
+const wchar_t *translate(const char *msgid)
+{
+    if (!currentCache || cacheGeneration != generation) {
+        const char *language = std::getenv("LANGUAGE");
+        currentCache = &caches[language ? language : ""];
+        cacheGeneration = generation;
+    }
+
+    Translation &translation = (*currentCache)[msgid];
+    if (translation.msgid != msgid) {
+        translation.msgid = msgid;
+        translation.text = utf8_to_wide(gettext(msgid));
+    }
+
+    return translation.text.c_str();
+}
 
 #ifndef _WIN32
 
@@ -28,83 +73,85 @@ void setLanguage(const std::string &language, bool replace)
         extern int _nl_msg_cat_cntr;
         ++_nl_msg_cat_cntr;
     }
-}
 
-// converts a string from one encoding to another using iconv library
-std::size_t convert(const char *to, const char *from,
-                    char *outbuf, std::size_t outbuf_size,
-                    char *inbuf, std::size_t inbuf_size) {
-    iconv_t cd = iconv_open(to, from);
+    generation++;
+}
 
-    char *inbuf_ptr = inbuf;
-    char *outbuf_ptr = outbuf;
+// decodes utf8 into code points and passes them to emit,
+//      invalid sequences become U+FFFD (wchar_t holds a whole code point here)
+template <typename Emit>
+static void decodeUtf8(const std::string &input, Emit emit)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(input.data());
+    const unsigned char *end = p + input.size();
+    while (p != end) {
+        unsigned int c = *p++;
+        // number of continuation bytes
+        int continuation = -1;
+        if (c < 0x80)
+            continuation = 0;
+        else if (c >= 0xC2 && c < 0xE0)
+            continuation = 1;
+        else if (c >= 0xE0 && c < 0xF0)
+            continuation = 2;
+        else if (c >= 0xF0 && c < 0xF5)
+            continuation = 3;
 
-    std::size_t *inbuf_left_ptr = &inbuf_size;
-    std::size_t *outbuf_left_ptr = &outbuf_size;
+        if (continuation < 0) {
+            emit(static_cast<wchar_t>(0xFFFD));
+            continue;
+        }
 
-    while (inbuf_size > 0)
-        iconv(cd, &inbuf_ptr, inbuf_left_ptr, &outbuf_ptr, outbuf_left_ptr);
+        if (continuation > 0)
+            c &= 0x3F >> continuation;
+        for (; continuation > 0 && p != end && (*p & 0xC0) == 0x80; continuation--)
+            c = (c << 6) | (*p++ & 0x3F);
 
-    iconv_close(cd);
-    return 0;
+        emit(static_cast<wchar_t>(continuation > 0 ? 0xFFFD : c));
+    }
 }
 
-// converts a utf8 string into a standard c++ utf16 string
+// converts a utf8 string into a standard c++ wide string
 std::wstring utf8_to_wide(const std::string &input) {
-    std::size_t inbuf_size = input.length() + 1;
-    // maximum possible size, every character is sizeof(wchar_t) bytes
-    std::size_t outbuf_size = (input.length() + 1) * sizeof(wchar_t);
-
-    char *inbuf = new char[inbuf_size];
-    memcpy(inbuf, input.c_str(), inbuf_size);
-    char *outbuf = new char[outbuf_size];
-    memset(outbuf, 0, outbuf_size);
-
-    convert("WCHAR_T", "UTF-8", outbuf, outbuf_size, inbuf, inbuf_size);
-    std::wstring out((wchar_t*)outbuf);
-
-    delete[] inbuf;
-    delete[] outbuf;
+    std::wstring out;
+    out.reserve(input.size());
+    decodeUtf8(input, [&out](wchar_t c) { out.push_back(c); });
 
     return out;
 }
 
-// converts a utf8 string into a utf16 irrlicht string
+// converts a utf8 string into a wide irrlicht string
 core::stringw utf8_to_irrwide(const std::string &input) {
-    std::size_t inbuf_size = input.length() + 1;
-    // maximum possible size, every character is sizeof(wchar_t) bytes
-    std::size_t outbuf_size = (input.length() + 1) * sizeof(wchar_t);
-
-    char *inbuf = new char[inbuf_size];
-    memcpy(inbuf, input.c_str(), inbuf_size);
-    char *outbuf = new char[outbuf_size];
-    memset(outbuf, 0, outbuf_size);
-
-    convert("WCHAR_T", "UTF-8", outbuf, outbuf_size, inbuf, inbuf_size);
-    core::stringw out((wchar_t *)outbuf);
-
-    delete[] inbuf;
-    delete[] outbuf;
+    core::stringw out;
+    out.reserve(input.size() + 1);
+    decodeUtf8(input, [&out](wchar_t c) { out.append(c); });
 
     return out;
 }
 
-// converts a utf16 c++ string into a utf8 string
+// converts a wide c++ string into a utf8 string
 std::string wide_to_utf8(const std::wstring &input) {
-    std::size_t inbuf_size = (input.length() + 1) * sizeof(wchar_t);
-    // maximum possible size: utf-8 encodes codepoints using 1 up to 6 bytes
-    std::size_t outbuf_size = (input.length() + 1) * 6;
+    std::string out;
+    out.reserve(input.size());
 
-    char *inbuf = new char[inbuf_size];
-    memcpy(inbuf, input.c_str(), inbuf_size);
-    char *outbuf = new char[outbuf_size];
-    memset(outbuf, 0, outbuf_size);
-
-    convert("UTF-8", "WCHAR_T", outbuf, outbuf_size, inbuf, inbuf_size);
-    std::string out(outbuf);
-
-    delete[] inbuf;
-    delete[] outbuf;
+    for (wchar_t wc : input) {
+        const unsigned int c = static_cast<unsigned int>(wc);
+        if (c < 0x80) {
+            out.push_back(c);
+        } else if (c < 0x800) {
+            out.push_back(0xC0 | (c >> 6));
+            out.push_back(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out.push_back(0xE0 | (c >> 12));
+            out.push_back(0x80 | ((c >> 6) & 0x3F));
+            out.push_back(0x80 | (c & 0x3F));
+        } else {
+            out.push_back(0xF0 | (c >> 18));
+            out.push_back(0x80 | ((c >> 12) & 0x3F));
+            out.push_back(0x80 | ((c >> 6) & 0x3F));
+            out.push_back(0x80 | (c & 0x3F));
+        }
+    }
 
     return out;
 }
@@ -116,6 +163,8 @@ void setLanguage(const std::string &language, bool)
     std::string str = "LANGUAGE=";
     str += language;
     _wputenv(utf8_to_wide(str).c_str());
+
+    generation++;
 }
 
 // converts a utf8 string into a standard c++ utf16 string
@@ -153,6 +202,57 @@ std::string wide_to_utf8(const std::wstring &input) {
 }
 #endif // _WIN32
 
+// reads the translations straight from the .mo file (see "The Format of GNU MO Files")
+std::wstring catalogueCharacters(const std::string &language)
+{
+    if (language.empty())
+        return std::wstring();
+
+    MappedFile file("media/locale/" + language + "/LC_MESSAGES/planerunner.mo");
+    if (!file.isOpen() || file.size() < 20)
+        return std::wstring();
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(file.data());
+    const std::size_t size = file.size();
+
+    // the magic number tells the byte order the file was written in
+    bool bigEndian;
+    if (data[0] == 0xde && data[1] == 0x12 && data[2] == 0x04 && data[3] == 0x95)
+        bigEndian = false;
+    else if (data[0] == 0x95 && data[1] == 0x04 && data[2] == 0x12 && data[3] == 0xde)
+        bigEndian = true;
+    else
+        return std::wstring();
+
+    auto read = [&](std::size_t offset) -> std::uint32_t {
+        const unsigned char *p = data + offset;
+        if (bigEndian)
+            return (std::uint32_t) p[0] << 24 | (std::uint32_t) p[1] << 16 | (std::uint32_t) p[2] << 8 | p[3];
+        else
+            return (std::uint32_t) p[3] << 24 | (std::uint32_t) p[2] << 16 | (std::uint32_t) p[1] << 8 | p[0];
+    };
+
+    const std::uint32_t count = read(8);
+    const std::uint32_t translations = read(16);
+    if (translations > size || count > (size - translations) / 8)
+        return std::wstring();
+
+    std::set<wchar_t> characters;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint32_t length = read(translations + i * 8);
+        const std::uint32_t offset = read(translations + i * 8 + 4);
+        if (offset > size || length > size - offset)
+            continue;
+
+        // plural forms are separated by zeros, the zeros are dropped with the rest
+        for (wchar_t c : utf8_to_wide(std::string(file.data() + offset, length)))
+            if (c >= L' ')
+                characters.insert(c);
+    }
+
+    return std::wstring(characters.begin(), characters.end());
+}
+
 // takes a key code and returns its name
 core::stringw keyCodeName(const EKEY_CODE &keyCode)
 {
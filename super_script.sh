@@ -1,7 +1,7 @@
 #!/usr/bin/env bash
 
 function show_usage {
-	echo "Usage: $0 ( ls | grep | count_lines | update_l11n | compile_l11n | add_license_headers | replace_license_headers)"
+	echo "Usage: $0 ( ls | grep | count_lines | update_l11n | compile_l11n | compile_meshes | add_license_headers | replace_license_headers)"
 	exit
 }
 
@@ -9,7 +9,7 @@ if [ -z "$1" ]; then
 	show_usage
 fi
 
-CXX_FILES=`find include/ src/ | grep -P '.*\.(cpp|h)$' | grep -v 'CGUITTFont'`\ main.cpp
+CXX_FILES=`find include/ src/ tools/ | grep -P '.*\.(cpp|h)$' | grep -v 'CGUITTFont'`\ main.cpp
 
 if [ "$1" == "ls" ]; then
 	for file in $CXX_FILES; do
@@ -28,6 +28,10 @@ elif [ "$1" == "compile_l11n" ]; then
 	for locale in media/locale/*; do
 		msgfmt $locale/LC_MESSAGES/planerunner.po -o $locale/LC_MESSAGES/planerunner.mo
 	done
+elif [ "$1" == "compile_meshes" ]; then
+	for model in media/models/*.obj; do
+		./bin/meshconv "$model"
+	done
 elif [ "$1" == "add_license_headers" ]; then
 	for file in $CXX_FILES; do
 		LICENSE_LINES=`wc -l < license_header`
@@ -0,0 +1,130 @@
+/* This file is part of Plaine.
+ *
+ * Plaine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Plaine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Plaine. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <BulletCollision/CollisionShapes/btConvexPointCloudShape.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include "ObjMesh.h"
+#include "BinaryMesh.h"
+
+static void usage(const char *program)
+{
+    std::cerr << "Usage: " << program << " model.obj [model.mesh]" << std::endl;
+    std::cerr << "       " << program << " --bench model.obj..." << std::endl;
+}
+
+struct Narrowphase {
+    double nanoseconds;         // per query
+    btScalar averageDistance;   // should be about the same for the hull and all the vertices
+};
+
+// average time of a GJK/EPA query between two shapes made of the same points
+//      placed at random close positions and orientations
+static Narrowphase narrowphase(std::vector<btVector3> points)
+{
+    constexpr std::size_t QUERIES = 100000;
+
+    btConvexPointCloudShape shapeA(points.data(), points.size(), btVector3(1, 1, 1));
+    btConvexPointCloudShape shapeB(points.data(), points.size(), btVector3(1, 1, 1));
+
+    btVoronoiSimplexSolver simplexSolver;
+    btGjkEpaPenetrationDepthSolver depthSolver;
+    btGjkPairDetector detector(&shapeA, &shapeB, &simplexSolver, &depthSolver);
+
+    std::default_random_engine engine(0);
+    std::uniform_real_distribution<btScalar> offset(-1.5f, 1.5f);
+    std::uniform_real_distribution<btScalar> angle(-3.14f, 3.14f);
+
+    btScalar distanceSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < QUERIES; i++) {
+        btGjkPairDetector::ClosestPointInput input;
+        input.m_transformA = btTransform(btQuaternion(angle(engine), angle(engine), angle(engine)));
+        input.m_transformB = btTransform(btQuaternion(angle(engine), angle(engine), angle(engine)),
+                                         btVector3(offset(engine), offset(engine), offset(engine)));
+
+        btPointCollector output;
+        detector.getClosestPoints(input, output, nullptr);
+        distanceSum += output.m_distance;
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    return { std::chrono::duration<double, std::nano>(finish - start).count() / QUERIES,
+             distanceSum / QUERIES };
+}
+
+static int bench(int argc, char *argv[])
+{
+    for (int i = 2; i < argc; i++) {
+        ObjMesh objMesh(argv[i]);
+        const std::vector<btVector3> &vertices = objMesh.getVertices();
+        if (vertices.empty()) {
+            std::cerr << "Error: \"" << argv[i] << "\" contains no vertices" << std::endl;
+            return 1;
+        }
+        const std::vector<btVector3> hull = BinaryMesh::hullPoints(vertices);
+
+        // the distances are printed so that the queries aren't optimized out
+        const Narrowphase all = narrowphase(vertices);
+        const Narrowphase hullOnly = narrowphase(hull);
+        std::cout << argv[i] << ":" << std::endl;
+        std::cout << "    all vertices: " << vertices.size() << " points, " << all.nanoseconds
+                  << " ns per query, average distance " << all.averageDistance << std::endl;
+        std::cout << "    hull:         " << hull.size() << " points, " << hullOnly.nanoseconds
+                  << " ns per query, average distance " << hullOnly.averageDistance << std::endl;
+    }
+
+    return 0;
+}
+
+// converts OBJ models into the binary format that BinaryMesh maps at runtime
+int main(int argc, char *argv[])
+{
+    if (argc >= 3 && std::string(argv[1]) == "--bench")
+        return bench(argc, argv);
+
+    if (argc < 2 || argc > 3) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const std::string input = argv[1];
+    const std::string output = argc == 3 ? argv[2] : BinaryMesh::binaryFilename(input);
+
+    ObjMesh objMesh(input);
+    if (objMesh.getVertices().empty()) {
+        std::cerr << "Error: \"" << input << "\" contains no vertices" << std::endl;
+        return 1;
+    }
+
+    if (!BinaryMesh::save(output, objMesh)) {
+        std::cerr << "Error: unable to write \"" << output << "\"" << std::endl;
+        return 1;
+    }
+
+    std::cout << input << " -> " << output << ": "
+              << objMesh.getVertices().size() << " vertices, "
+              << BinaryMesh::hullPoints(objMesh.getVertices()).size() << " hull points, "
+              << objMesh.getTriangleIndices().size() / 3 << " triangles" << std::endl;
+
+    return 0;
+}